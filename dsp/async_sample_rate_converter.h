@@ -0,0 +1,329 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Asynchronous sample rate converter, for arbitrary (and slowly varying)
+// ratios, such as 44.1kHz to 48kHz, or between two audio interfaces running
+// from different clocks.
+//
+// The input is written into a FIFO, from which the output is read. Each
+// output sample is computed by a num_taps FIR (windowed sinc) whose phase is
+// interpolated between num_phases precomputed phases. The position in the
+// input is tracked with 32 bits of fractional precision.
+//
+// When drift tracking is enabled, the ratio is continuously corrected by a PI
+// loop, so that the number of samples in the FIFO stays at the latency given
+// to Init(): the writer and the reader can then run from unsynchronized
+// clocks, the ratio passed to Init() being only their nominal ratio.
+//
+// num_taps must be a multiple of the SIMD width, and buffer_size larger than
+// the latency plus num_taps plus the largest block written at once.
+
+#ifndef STMLIB_DSP_ASYNC_SAMPLE_RATE_CONVERTER_H_
+#define STMLIB_DSP_ASYNC_SAMPLE_RATE_CONVERTER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+template<size_t num_taps, size_t num_phases, size_t buffer_size>
+class AsyncSampleRateConverter {
+ private:
+  enum {
+    width = SimdWidth<num_taps>::value
+  };
+  typedef typename FloatVector<width>::type Vector;
+  
+ public:
+  AsyncSampleRateConverter() { }
+  ~AsyncSampleRateConverter() { }
+  
+  // ratio is the nominal ratio between the input and output sample rates.
+  // latency is the number of samples kept in the FIFO (in addition to the
+  // num_taps samples covered by the filter).
+  void Init(float ratio, size_t latency) {
+    ratio_ = ratio;
+    latency_ = static_cast<float>(latency);
+    drift_tracking_ = false;
+    set_time_constant(65536.0f);
+    DesignFilter(0.45f * std::min(1.0f, 1.0f / ratio));
+    Reset();
+  }
+  
+  void Reset() {
+    std::fill(&buffer_[0], &buffer_[2 * buffer_size], 0.0f);
+    write_ptr_ = 0;
+    read_ptr_ = 0;
+    size_ = 0;
+    phase_ = 0;
+    primed_ = false;
+    correction_ = 0.0f;
+    integral_ = 0.0f;
+    level_ = latency_;
+    set_ratio(ratio_);
+  }
+  
+  // Changes the nominal ratio without affecting the filter, which was
+  // designed for the ratio given to Init().
+  inline void set_ratio(float ratio) {
+    ratio_ = ratio;
+    UpdateIncrement();
+  }
+  
+  inline void set_drift_tracking(bool enabled) {
+    drift_tracking_ = enabled;
+    if (!enabled) {
+      correction_ = 0.0f;
+      integral_ = 0.0f;
+      UpdateIncrement();
+    }
+  }
+  
+  // Time constant of the drift tracking loop, in output samples. The fill
+  // level of the FIFO is averaged over a quarter of this duration.
+  inline void set_time_constant(float num_samples) {
+    float omega = 1.0f / num_samples;
+    kp_ = 2.0f * omega;
+    ki_ = omega * omega;
+    smoothing_ = 4.0f * omega;
+  }
+  
+  // Ratio currently used, including the drift correction.
+  inline float ratio() const { return ratio_ * (1.0f + correction_); }
+  
+  // Number of samples in the FIFO, beyond the filter's window. Negative while
+  // the FIFO does not fill the window yet, which the drift tracking loop sees
+  // as an underrun.
+  inline float level() const {
+    float fractional = static_cast<float>(phase_) * (1.0f / 4294967296.0f);
+    return static_cast<float>(size_) - static_cast<float>(num_taps) -
+        fractional;
+  }
+  
+  void Write(const float* in, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      buffer_[write_ptr_] = buffer_[write_ptr_ + buffer_size] = in[i];
+      if (++write_ptr_ == buffer_size) {
+        write_ptr_ = 0;
+      }
+    }
+    size_ += size;
+    
+    // On overflow, drop the oldest samples so that the FIFO is back at its
+    // nominal latency.
+    if (size_ >= buffer_size) {
+      size_t target = static_cast<size_t>(latency_) + num_taps;
+      Skip(size_ - target);
+    }
+  }
+  
+  // Always writes size samples - silence when the FIFO has run dry, until
+  // it has been filled again to its nominal latency.
+  void Read(float* out, size_t size) {
+    if (drift_tracking_ && primed_) {
+      TrackDrift(size);
+    }
+    
+    size_t target = static_cast<size_t>(latency_) + num_taps;
+    if (!primed_ && size_ >= target) {
+      primed_ = true;
+      Skip(size_ - target);
+      phase_ = 0;
+    }
+    
+    size_t n = primed_ ? std::min(size, available()) : 0;
+    Render(out, n);
+    if (n < size) {
+      std::fill(&out[n], &out[size], 0.0f);
+      primed_ = false;
+    }
+  }
+  
+  // Synchronous use (fixed ratio, no drift tracking): converts the whole
+  // input block and returns the number of output samples written - at most
+  // ceil(size / ratio) + 1.
+  size_t Process(const float* in, size_t size, float* out) {
+    Write(in, size);
+    size_t n = size_ >= num_taps ? available() : 0;
+    Render(out, n);
+    return n;
+  }
+  
+  inline size_t delay() const { return num_taps / 2; }
+  
+ private:
+  // Number of output samples which can be computed from the FIFO contents.
+  inline size_t available() const {
+    if (size_ < num_taps) {
+      return 0;
+    }
+    uint64_t remaining = static_cast<uint64_t>(size_ - num_taps) << 32;
+    remaining += 0xffffffff - phase_;
+    return static_cast<size_t>(remaining / increment_) + 1;
+  }
+  
+  inline void Skip(size_t n) {
+    size_ -= n;
+    read_ptr_ += n;
+    while (read_ptr_ >= buffer_size) {
+      read_ptr_ -= buffer_size;
+    }
+  }
+  
+  inline void UpdateIncrement() {
+    double increment = static_cast<double>(ratio_) * (1.0 + correction_);
+    increment_ = static_cast<uint64_t>(increment * 4294967296.0 + 0.5);
+  }
+  
+  inline void TrackDrift(size_t size) {
+    float n = static_cast<float>(size);
+    level_ += (level() - level_) * std::min(1.0f, smoothing_ * n);
+    float error = level_ - latency_;
+    integral_ += error * n;
+    
+    // The input is consumed ratio * (1 + correction) times faster than the
+    // output is produced, so this is a second order loop with a time
+    // constant of 1 / omega, critically damped.
+    float correction = (kp_ * error + ki_ * integral_) / ratio_;
+    CONSTRAIN(correction, -0.01f, 0.01f);
+    correction_ = correction;
+    UpdateIncrement();
+  }
+  
+  inline void Render(float* out, size_t size) {
+    const float* x = &buffer_[read_ptr_];
+    const float* wrap = &buffer_[buffer_size];
+    uint32_t phase = phase_;
+    const uint32_t increment_fractional = static_cast<uint32_t>(increment_);
+    const size_t increment_integral = static_cast<size_t>(increment_ >> 32);
+    size_t consumed = 0;
+    
+    for (size_t i = 0; i < size; ++i) {
+      uint64_t scaled_phase = static_cast<uint64_t>(phase) * num_phases;
+      const float* h = &filter_[(scaled_phase >> 32) * num_taps];
+      const float* dh = &delta_[(scaled_phase >> 32) * num_taps];
+      Vector t = SimdSplat<Vector>(static_cast<float>(
+          static_cast<uint32_t>(scaled_phase)) * (1.0f / 4294967296.0f));
+      Vector acc = Vector();
+      for (size_t k = 0; k < num_taps; k += width) {
+        Vector coefficient = SimdLoad<Vector>(h + k) +
+            SimdLoad<Vector>(dh + k) * t;
+        acc += SimdLoad<Vector>(x + k) * coefficient;
+      }
+      out[i] = SimdSum(acc);
+      
+      uint32_t previous = phase;
+      phase += increment_fractional;
+      size_t step = increment_integral + (phase < previous ? 1 : 0);
+      consumed += step;
+      x += step;
+      x -= x >= wrap ? buffer_size : 0;
+    }
+    phase_ = phase;
+    Skip(consumed);
+  }
+  
+  static inline double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+    }
+    return sum;
+  }
+  
+  // Kaiser-windowed sinc. The coefficients of phase p are the values of the
+  // impulse response at p / num_phases + num_taps / 2 - 1 - k, normalized to
+  // a unit DC gain.
+  void DesignFilter(float cutoff) {
+    const double beta = 8.0;
+    const double pi = 3.141592653589793;
+    const double half_length = static_cast<double>(num_taps) / 2.0;
+    const double window_scale = 1.0 / BesselI0(beta);
+    
+    float previous[num_taps];
+    for (size_t p = 0; p <= num_phases; ++p) {
+      double t = static_cast<double>(p) / num_phases + half_length - 1.0;
+      double phase[num_taps];
+      double sum = 0.0;
+      for (size_t k = 0; k < num_taps; ++k) {
+        double d = t - static_cast<double>(k);
+        double r = d / half_length;
+        double window = r * r < 1.0
+            ? BesselI0(beta * sqrt(1.0 - r * r)) * window_scale
+            : 0.0;
+        double x = 2.0 * pi * cutoff * d;
+        double sinc = d == 0.0 ? 1.0 : sin(x) / x;
+        phase[k] = 2.0 * cutoff * sinc * window;
+        sum += phase[k];
+      }
+      for (size_t k = 0; k < num_taps; ++k) {
+        float h = static_cast<float>(phase[k] / sum);
+        if (p != num_phases) {
+          filter_[p * num_taps + k] = h;
+        }
+        if (p != 0) {
+          delta_[(p - 1) * num_taps + k] = h - previous[k];
+        }
+        previous[k] = h;
+      }
+    }
+  }
+  
+  float filter_[num_phases * num_taps];
+  float delta_[num_phases * num_taps];
+  
+  // The samples are written twice, so that the filter always reads a
+  // contiguous block.
+  float buffer_[2 * buffer_size];
+  size_t write_ptr_;
+  size_t read_ptr_;
+  size_t size_;
+  uint32_t phase_;
+  uint64_t increment_;
+  bool primed_;
+  
+  float ratio_;
+  float latency_;
+  bool drift_tracking_;
+  float correction_;
+  float integral_;
+  float level_;
+  float kp_;
+  float ki_;
+  float smoothing_;
+  
+  DISALLOW_COPY_AND_ASSIGN(AsyncSampleRateConverter);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_ASYNC_SAMPLE_RATE_CONVERTER_H_
@@ -0,0 +1,163 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Math functions which can be evaluated by the compiler, to generate tables
+// directly in flash. Requires C++14.
+
+#ifndef STMLIB_DSP_CONSTEXPR_MATH_H_
+#define STMLIB_DSP_CONSTEXPR_MATH_H_
+
+#if __cplusplus < 201402L
+#error "stmlib/dsp/constexpr_math.h requires C++14."
+#endif  // __cplusplus
+
+#include "stmlib/stmlib.h"
+
+namespace stmlib {
+
+constexpr double kConstexprPi = 3.14159265358979323846;
+
+// Taylor series, valid for |x| <= pi / 2.
+constexpr double ConstexprSinReduced(double x) {
+  double x2 = x * x;
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 16; ++n) {
+    term *= -x2 / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double ConstexprCosReduced(double x) {
+  double x2 = x * x;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int n = 1; n < 16; ++n) {
+    term *= -x2 / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double ConstexprSin(double x) {
+  // Reduce to [-pi, pi], then to [-pi / 2, pi / 2].
+  double turns = x / (2.0 * kConstexprPi);
+  long long n = static_cast<long long>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+  x -= static_cast<double>(n) * 2.0 * kConstexprPi;
+  if (x > kConstexprPi / 2.0) {
+    x = kConstexprPi - x;
+  } else if (x < -kConstexprPi / 2.0) {
+    x = -kConstexprPi - x;
+  }
+  return ConstexprSinReduced(x);
+}
+
+constexpr double ConstexprCos(double x) {
+  return ConstexprSin(x + kConstexprPi / 2.0);
+}
+
+// Valid for |x| < pi / 2.
+constexpr double ConstexprTan(double x) {
+  return ConstexprSinReduced(x) / ConstexprCosReduced(x);
+}
+
+// Newton's method. Returns 0 for x <= 0.
+constexpr double ConstexprSqrt(double x) {
+  if (x <= 0.0) {
+    return 0.0;
+  }
+  double y = x > 1.0 ? x : 1.0;
+  for (int n = 0; n < 128; ++n) {
+    double next = 0.5 * (y + x / y);
+    if (next >= y) {
+      break;
+    }
+    y = next;
+  }
+  return y;
+}
+
+constexpr double ConstexprExp(double x) {
+  // x = n * ln(2) + r, with |r| <= ln(2) / 2.
+  const double ln2 = 0.69314718055994530942;
+  double turns = x / ln2;
+  long long n = static_cast<long long>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+  double r = x - static_cast<double>(n) * ln2;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int k = 1; k < 20; ++k) {
+    term *= r / k;
+    sum += term;
+  }
+  for (; n > 0; --n) {
+    sum *= 2.0;
+  }
+  for (; n < 0; ++n) {
+    sum *= 0.5;
+  }
+  return sum;
+}
+
+// Valid for x > 0.
+constexpr double ConstexprLog(double x) {
+  // x = 2^e * m, with m in [sqrt(2) / 2, sqrt(2)], and
+  // log(m) = 2 * atanh((m - 1) / (m + 1)).
+  const double ln2 = 0.69314718055994530942;
+  int e = 0;
+  for (; x > 1.41421356237309504880; x *= 0.5) {
+    ++e;
+  }
+  for (; x < 0.70710678118654752440; x *= 2.0) {
+    --e;
+  }
+  double z = (x - 1.0) / (x + 1.0);
+  double z2 = z * z;
+  double term = z;
+  double sum = 0.0;
+  for (int k = 1; k < 40; k += 2) {
+    sum += term / k;
+    term *= z2;
+  }
+  return 2.0 * sum + e * ln2;
+}
+
+// Zeroth-order modified Bessel function of the first kind, for the Kaiser
+// window. The series converges quickly for the values of beta used in
+// practice (< 20).
+constexpr double ConstexprBesselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 48; ++k) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_CONSTEXPR_MATH_H_
@@ -32,6 +32,8 @@
 
 #include "stmlib/stmlib.h"
 
+#include "stmlib/dsp/denormals.h"
+
 #include <cmath>
 #include <algorithm>
 
@@ -48,7 +50,8 @@ enum FrequencyApproximation {
   FREQUENCY_EXACT,
   FREQUENCY_ACCURATE,
   FREQUENCY_FAST,
-  FREQUENCY_DIRTY
+  FREQUENCY_DIRTY,
+  FREQUENCY_LUT
 };
 
 #define M_PI_F float(M_PI)
@@ -59,6 +62,27 @@ enum FrequencyApproximation {
 #define M_PI_POW_9 M_PI_POW_7 * M_PI_POW_2
 #define M_PI_POW_11 M_PI_POW_9 * M_PI_POW_2
 
+}  // namespace stmlib
+
+#if __cplusplus >= 201402L
+#include "stmlib/dsp/tan_lut.h"
+#else
+namespace stmlib {
+
+// The table of FREQUENCY_LUT is built by a C++14 constexpr constructor. With
+// older standards, using it is an error rather than a silent fallback to tanf,
+// which would make the mode picked for speed the slowest.
+template<FrequencyApproximation approximation>
+struct FrequencyLutRequiresCpp14 { };
+
+template<>
+struct FrequencyLutRequiresCpp14<FREQUENCY_LUT>;
+
+}  // namespace stmlib
+#endif  // __cplusplus
+
+namespace stmlib {
+
 class DCBlocker {
  public:
   DCBlocker() { }
@@ -80,7 +104,7 @@ class DCBlocker {
       *in_out++ = y = y * pole + x - old_x;
     }
     x_ = x;
-    y_ = y;
+    y_ = PreventDenormals(y);
   }
   
  private:
@@ -130,6 +154,15 @@ class OnePole {
       const float e = 9.5168091e-03f * M_PI_POW_11;
       float f2 = f * f;
       return f * (M_PI_F + f2 * (a + f2 * (b + f2 * (c + f2 * (d + f2 * e)))));
+    } else if (approximation == FREQUENCY_LUT) {
+#if __cplusplus >= 201402L
+      // Compile-time table, accurate over the whole range.
+      return LookupTan(f);
+#else
+      // Does not compile for FREQUENCY_LUT, see FrequencyLutRequiresCpp14.
+      (void)sizeof(FrequencyLutRequiresCpp14<approximation>);
+      return 0.0f;
+#endif  // __cplusplus
     }
   }
   
@@ -162,6 +195,7 @@ class OnePole {
       *in_out = Process<mode>(*in_out);
       ++in_out;
     }
+    state_ = PreventDenormals(state_);
   }
   
  private:
@@ -304,8 +338,8 @@ class Svf {
       ++out;
       ++in;
     }
-    state_1_ = state_1;
-    state_2_ = state_2;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
   }
   
   template<FilterMode mode>
@@ -336,8 +370,8 @@ class Svf {
       ++out;
       ++in;
     }
-    state_1_ = state_1;
-    state_2_ = state_2;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
   }
   
   template<FilterMode mode>
@@ -368,10 +402,166 @@ class Svf {
       out += stride;
       in += stride;
     }
-    state_1_ = state_1;
-    state_2_ = state_2;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
   }
-  
+
+  // Audio-rate modulation of the cutoff frequency. g is recomputed for each
+  // sample from the frequency buffer - use FREQUENCY_DIRTY or FREQUENCY_FAST
+  // to keep this cheap. The coefficients are left at their last value.
+  template<FilterMode mode, FrequencyApproximation approximation>
+  inline void ProcessModulated(
+      const float* in,
+      float* out,
+      const float* f,
+      float resonance,
+      size_t size) {
+    float hp, bp, lp;
+    float state_1 = state_1_;
+    float state_2 = state_2_;
+    float g = g_;
+    float h = h_;
+    const float r = 1.0f / resonance;
+
+    while (size--) {
+      g = OnePole::tan<approximation>(*f++);
+      h = 1.0f / (1.0f + r * g + g * g);
+      hp = (*in - r * state_1 - g * state_1 - state_2) * h;
+      bp = g * hp + state_1;
+      state_1 = g * hp + bp;
+      lp = g * bp + state_2;
+      state_2 = g * bp + lp;
+
+      float value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_BAND_PASS) {
+        value = bp;
+      } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+        value = bp * r;
+      } else {
+        value = hp;
+      }
+
+      *out = value;
+      ++out;
+      ++in;
+    }
+    g_ = g;
+    r_ = r;
+    h_ = h;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
+  }
+
+  // Same thing, with both frequency and resonance modulated.
+  template<FilterMode mode, FrequencyApproximation approximation>
+  inline void ProcessModulated(
+      const float* in,
+      float* out,
+      const float* f,
+      const float* resonance,
+      size_t size) {
+    float hp, bp, lp;
+    float state_1 = state_1_;
+    float state_2 = state_2_;
+    float g = g_;
+    float r = r_;
+    float h = h_;
+
+    while (size--) {
+      g = OnePole::tan<approximation>(*f++);
+      r = 1.0f / *resonance++;
+      h = 1.0f / (1.0f + r * g + g * g);
+      hp = (*in - r * state_1 - g * state_1 - state_2) * h;
+      bp = g * hp + state_1;
+      state_1 = g * hp + bp;
+      lp = g * bp + state_2;
+      state_2 = g * bp + lp;
+
+      float value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_BAND_PASS) {
+        value = bp;
+      } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+        value = bp * r;
+      } else {
+        value = hp;
+      }
+
+      *out = value;
+      ++out;
+      ++in;
+    }
+    g_ = g;
+    r_ = r;
+    h_ = h;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
+  }
+
+  // Cheapest variant: the coefficients are linearly ramped, through the
+  // block, from their current value to the value corresponding to the
+  // target frequency and resonance. The error on h is negligible as long as
+  // the frequency does not move by more than a few semitones per block.
+  template<FilterMode mode, FrequencyApproximation approximation>
+  inline void ProcessModulated(
+      const float* in,
+      float* out,
+      size_t size,
+      float f_end,
+      float resonance_end) {
+    if (!size) {
+      return;
+    }
+    float hp, bp, lp;
+    float state_1 = state_1_;
+    float state_2 = state_2_;
+    float g = g_;
+    float r = r_;
+    float h = h_;
+
+    const float g_end = OnePole::tan<approximation>(f_end);
+    const float r_end = 1.0f / resonance_end;
+    const float h_end = 1.0f / (1.0f + r_end * g_end + g_end * g_end);
+    const float step = 1.0f / static_cast<float>(size);
+    const float g_increment = (g_end - g) * step;
+    const float r_increment = (r_end - r) * step;
+    const float h_increment = (h_end - h) * step;
+
+    while (size--) {
+      g += g_increment;
+      r += r_increment;
+      h += h_increment;
+      hp = (*in - r * state_1 - g * state_1 - state_2) * h;
+      bp = g * hp + state_1;
+      state_1 = g * hp + bp;
+      lp = g * bp + state_2;
+      state_2 = g * bp + lp;
+
+      float value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_BAND_PASS) {
+        value = bp;
+      } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+        value = bp * r;
+      } else {
+        value = hp;
+      }
+
+      *out = value;
+      ++out;
+      ++in;
+    }
+    g_ = g_end;
+    r_ = r_end;
+    h_ = h_end;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
+  }
+
   inline void ProcessMultimode(
       const float* in,
       float* out,
@@ -393,8 +583,8 @@ class Svf {
       ++in;
       ++out;
     }
-    state_1_ = state_1;
-    state_2_ = state_2;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
   }
   
   inline void ProcessMultimodeLPtoHP(
@@ -418,8 +608,8 @@ class Svf {
       ++in;
       ++out;
     }
-    state_1_ = state_1;
-    state_2_ = state_2;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
   }
   
   template<FilterMode mode>
@@ -454,8 +644,8 @@ class Svf {
       ++out_2;
       ++in;
     }
-    state_1_ = state_1;
-    state_2_ = state_2;
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
   }
   
   inline float g() const { return g_; }
@@ -475,6 +665,342 @@ class Svf {
 
 
 
+// Chain of SVFs (eg. 24dB/oct or 48dB/oct) processed in a single pass, with
+// the state of all stages kept in registers. Each stage can have its own
+// coefficients.
+template<size_t num_stages>
+class SvfCascade {
+ public:
+  SvfCascade() { }
+  ~SvfCascade() { }
+
+  void Init() {
+    set_f_q<FREQUENCY_DIRTY>(0.01f, 100.0f);
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&state_1_[0], &state_1_[num_stages], 0.0f);
+    std::fill(&state_2_[0], &state_2_[num_stages], 0.0f);
+  }
+
+  // Set all parameters of a stage from LUT.
+  inline void set_g_r_h(size_t stage, float g, float r, float h) {
+    g_[stage] = g;
+    r_[stage] = r;
+    h_[stage] = h;
+  }
+
+  // Set frequency and resonance of a stage from true units.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(size_t stage, float f, float resonance) {
+    g_[stage] = OnePole::tan<approximation>(f);
+    r_[stage] = 1.0f / resonance;
+    h_[stage] = 1.0f / (1.0f + r_[stage] * g_[stage] + g_[stage] * g_[stage]);
+  }
+
+  // Same frequency and resonance for all stages.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(float f, float resonance) {
+    set_f_q<approximation>(0, f, resonance);
+    for (size_t i = 1; i < num_stages; ++i) {
+      g_[i] = g_[0];
+      r_[i] = r_[0];
+      h_[i] = h_[0];
+    }
+  }
+
+  template<FilterMode mode>
+  inline void Process(const float* in, float* out, size_t size) {
+    float g[num_stages], r[num_stages], h[num_stages];
+    float state_1[num_stages], state_2[num_stages];
+    for (size_t i = 0; i < num_stages; ++i) {
+      g[i] = g_[i];
+      r[i] = r_[i];
+      h[i] = h_[i];
+      state_1[i] = state_1_[i];
+      state_2[i] = state_2_[i];
+    }
+
+    while (size--) {
+      float value = *in++;
+      for (size_t i = 0; i < num_stages; ++i) {
+        float hp, bp, lp;
+        hp = (value - r[i] * state_1[i] - g[i] * state_1[i] - state_2[i]) * \
+            h[i];
+        bp = g[i] * hp + state_1[i];
+        state_1[i] = g[i] * hp + bp;
+        lp = g[i] * bp + state_2[i];
+        state_2[i] = g[i] * bp + lp;
+
+        if (mode == FILTER_MODE_LOW_PASS) {
+          value = lp;
+        } else if (mode == FILTER_MODE_BAND_PASS) {
+          value = bp;
+        } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+          value = bp * r[i];
+        } else if (mode == FILTER_MODE_HIGH_PASS) {
+          value = hp;
+        }
+      }
+      *out++ = value;
+    }
+
+    for (size_t i = 0; i < num_stages; ++i) {
+      state_1_[i] = PreventDenormals(state_1[i]);
+      state_2_[i] = PreventDenormals(state_2[i]);
+    }
+  }
+
+ private:
+  float g_[num_stages];
+  float r_[num_stages];
+  float h_[num_stages];
+
+  float state_1_[num_stages];
+  float state_2_[num_stages];
+
+  DISALLOW_COPY_AND_ASSIGN(SvfCascade);
+};
+
+
+
+// Chain of one-pole filters processed in a single pass.
+template<size_t num_stages>
+class OnePoleCascade {
+ public:
+  OnePoleCascade() { }
+  ~OnePoleCascade() { }
+
+  void Init() {
+    set_f<FREQUENCY_DIRTY>(0.01f);
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&state_[0], &state_[num_stages], 0.0f);
+  }
+
+  template<FrequencyApproximation approximation>
+  inline void set_f(size_t stage, float f) {
+    g_[stage] = OnePole::tan<approximation>(f);
+    gi_[stage] = 1.0f / (1.0f + g_[stage]);
+  }
+
+  template<FrequencyApproximation approximation>
+  inline void set_f(float f) {
+    set_f<approximation>(0, f);
+    std::fill(&g_[1], &g_[num_stages], g_[0]);
+    std::fill(&gi_[1], &gi_[num_stages], gi_[0]);
+  }
+
+  template<FilterMode mode>
+  inline void Process(float* in_out, size_t size) {
+    float g[num_stages], gi[num_stages], state[num_stages];
+    for (size_t i = 0; i < num_stages; ++i) {
+      g[i] = g_[i];
+      gi[i] = gi_[i];
+      state[i] = state_[i];
+    }
+
+    while (size--) {
+      float value = *in_out;
+      for (size_t i = 0; i < num_stages; ++i) {
+        float lp;
+        lp = (g[i] * value + state[i]) * gi[i];
+        state[i] = g[i] * (value - lp) + lp;
+        if (mode == FILTER_MODE_LOW_PASS) {
+          value = lp;
+        } else if (mode == FILTER_MODE_HIGH_PASS) {
+          value = value - lp;
+        } else {
+          value = 0.0f;
+        }
+      }
+      *in_out++ = value;
+    }
+
+    for (size_t i = 0; i < num_stages; ++i) {
+      state_[i] = PreventDenormals(state[i]);
+    }
+  }
+
+ private:
+  float g_[num_stages];
+  float gi_[num_stages];
+  float state_[num_stages];
+
+  DISALLOW_COPY_AND_ASSIGN(OnePoleCascade);
+};
+
+
+
+// Linked-coefficient SVF for num_channels interleaved channels (eg. stereo
+// frames). Each frame is read and written only once.
+template<size_t num_channels>
+class InterleavedSvf {
+ public:
+  InterleavedSvf() { }
+  ~InterleavedSvf() { }
+
+  void Init() {
+    set_f_q<FREQUENCY_DIRTY>(0.01f, 100.0f);
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&state_1_[0], &state_1_[num_channels], 0.0f);
+    std::fill(&state_2_[0], &state_2_[num_channels], 0.0f);
+  }
+
+  // Copy settings from another filter.
+  inline void set(const Svf& f) {
+    g_ = f.g();
+    r_ = f.r();
+    h_ = f.h();
+  }
+
+  // Set all parameters from LUT.
+  inline void set_g_r_h(float g, float r, float h) {
+    g_ = g;
+    r_ = r;
+    h_ = h;
+  }
+
+  // Set frequency and resonance from true units.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(float f, float resonance) {
+    g_ = OnePole::tan<approximation>(f);
+    r_ = 1.0f / resonance;
+    h_ = 1.0f / (1.0f + r_ * g_ + g_ * g_);
+  }
+
+  // in and out contain size frames of num_channels samples.
+  template<FilterMode mode>
+  inline void Process(const float* in, float* out, size_t size) {
+    const float g = g_;
+    const float r = r_;
+    const float h = h_;
+    float state_1[num_channels], state_2[num_channels];
+    for (size_t c = 0; c < num_channels; ++c) {
+      state_1[c] = state_1_[c];
+      state_2[c] = state_2_[c];
+    }
+
+    while (size--) {
+      for (size_t c = 0; c < num_channels; ++c) {
+        float hp, bp, lp;
+        hp = (in[c] - r * state_1[c] - g * state_1[c] - state_2[c]) * h;
+        bp = g * hp + state_1[c];
+        state_1[c] = g * hp + bp;
+        lp = g * bp + state_2[c];
+        state_2[c] = g * bp + lp;
+
+        float value;
+        if (mode == FILTER_MODE_LOW_PASS) {
+          value = lp;
+        } else if (mode == FILTER_MODE_BAND_PASS) {
+          value = bp;
+        } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+          value = bp * r;
+        } else {
+          value = hp;
+        }
+        out[c] = value;
+      }
+      in += num_channels;
+      out += num_channels;
+    }
+
+    for (size_t c = 0; c < num_channels; ++c) {
+      state_1_[c] = PreventDenormals(state_1[c]);
+      state_2_[c] = PreventDenormals(state_2[c]);
+    }
+  }
+
+  inline float g() const { return g_; }
+  inline float r() const { return r_; }
+  inline float h() const { return h_; }
+
+ private:
+  float g_;
+  float r_;
+  float h_;
+
+  float state_1_[num_channels];
+  float state_2_[num_channels];
+
+  DISALLOW_COPY_AND_ASSIGN(InterleavedSvf);
+};
+
+typedef InterleavedSvf<2> StereoSvf;
+
+
+
+// Linked-coefficient one-pole filter for num_channels interleaved channels.
+template<size_t num_channels>
+class InterleavedOnePole {
+ public:
+  InterleavedOnePole() { }
+  ~InterleavedOnePole() { }
+
+  void Init() {
+    set_f<FREQUENCY_DIRTY>(0.01f);
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&state_[0], &state_[num_channels], 0.0f);
+  }
+
+  template<FrequencyApproximation approximation>
+  inline void set_f(float f) {
+    g_ = OnePole::tan<approximation>(f);
+    gi_ = 1.0f / (1.0f + g_);
+  }
+
+  // in_out contains size frames of num_channels samples.
+  template<FilterMode mode>
+  inline void Process(float* in_out, size_t size) {
+    const float g = g_;
+    const float gi = gi_;
+    float state[num_channels];
+    std::copy(&state_[0], &state_[num_channels], &state[0]);
+
+    while (size--) {
+      for (size_t c = 0; c < num_channels; ++c) {
+        float in = in_out[c];
+        float lp;
+        lp = (g * in + state[c]) * gi;
+        state[c] = g * (in - lp) + lp;
+        if (mode == FILTER_MODE_LOW_PASS) {
+          in_out[c] = lp;
+        } else if (mode == FILTER_MODE_HIGH_PASS) {
+          in_out[c] = in - lp;
+        } else {
+          in_out[c] = 0.0f;
+        }
+      }
+      in_out += num_channels;
+    }
+
+    for (size_t c = 0; c < num_channels; ++c) {
+      state_[c] = PreventDenormals(state[c]);
+    }
+  }
+
+ private:
+  float g_;
+  float gi_;
+  float state_[num_channels];
+
+  DISALLOW_COPY_AND_ASSIGN(InterleavedOnePole);
+};
+
+typedef InterleavedOnePole<2> StereoOnePole;
+
+
+
 // Naive Chamberlin SVF.
 class NaiveSvf {
  public:
@@ -764,6 +1290,128 @@ class CrossoverSvf {
   DISALLOW_COPY_AND_ASSIGN(CrossoverSvf);
 };
 
+
+
+// Splits a signal into num_bands phase-coherent bands with Linkwitz-Riley
+// (Butterworth squared) crossovers, in a single pass. As in CrossoverSvf,
+// each low-pass/high-pass pair is made of two Butterworth sections. Each band
+// is also passed through the all-pass response of the crossovers above it,
+// so that the bands sum back to an all-pass version of the input.
+//
+// The low-pass and high-pass paths of a crossover share their first ZDF
+// section. The states of all sections are stored contiguously.
+template<size_t num_bands>
+class MultibandCrossover {
+ private:
+  STATIC_ASSERT(num_bands >= 2, at_least_2_bands_are_needed);
+  
+  enum {
+    num_crossovers = num_bands - 1,
+    num_allpasses = (num_bands - 1) * (num_bands - 2) / 2
+  };
+
+ public:
+  MultibandCrossover() { }
+  ~MultibandCrossover() { }
+
+  void Init() {
+    for (size_t i = 0; i < num_crossovers; ++i) {
+      set_f<FREQUENCY_DIRTY>(i, 0.01f * static_cast<float>(i + 1));
+    }
+    Reset();
+  }
+
+  void Reset() {
+    for (size_t i = 0; i < num_crossovers; ++i) {
+      std::fill(&crossover_[i].state[0], &crossover_[i].state[6], 0.0f);
+    }
+    std::fill(&allpass_state_[0], &allpass_state_[2 * num_allpasses + 2], 0.0f);
+  }
+
+  // Crossover frequencies must be set in increasing order.
+  template<FrequencyApproximation approximation>
+  inline void set_f(size_t crossover, float f) {
+    float g = OnePole::tan<approximation>(f);
+    crossover_[crossover].g = g;
+    crossover_[crossover].h = 1.0f / (1.0f + kButterworthR * g + g * g);
+  }
+
+  // out[band] is a buffer of size samples. Band 0 is the lowest.
+  inline void Process(const float* in, float** out, size_t size) {
+    Crossover crossover[num_crossovers];
+    float allpass_state[2 * num_allpasses + 2];
+    std::copy(&crossover_[0], &crossover_[num_crossovers], &crossover[0]);
+    std::copy(
+        &allpass_state_[0],
+        &allpass_state_[2 * num_allpasses],
+        &allpass_state[0]);
+
+    for (size_t n = 0; n < size; ++n) {
+      float x = in[n];
+      float* ap_state = &allpass_state[0];
+      for (size_t i = 0; i < num_crossovers; ++i) {
+        Crossover* c = &crossover[i];
+        float lp, bp, hp, low, high;
+        Tick(c->g, c->h, x, &c->state[0], &lp, &bp, &hp);
+        Tick(c->g, c->h, lp, &c->state[2], &low, &bp, &high);
+        x = hp;
+        Tick(c->g, c->h, x, &c->state[4], &lp, &bp, &high);
+
+        // Compensate for the phase shift of the crossovers above.
+        for (size_t j = i + 1; j < num_crossovers; ++j) {
+          Tick(crossover[j].g, crossover[j].h, low, ap_state, &lp, &bp, &hp);
+          low -= 2.0f * kButterworthR * bp;
+          ap_state += 2;
+        }
+        out[i][n] = low;
+        x = high;
+      }
+      out[num_crossovers][n] = x;
+    }
+
+    for (size_t i = 0; i < num_crossovers; ++i) {
+      for (size_t j = 0; j < 6; ++j) {
+        crossover[i].state[j] = PreventDenormals(crossover[i].state[j]);
+      }
+    }
+    for (size_t i = 0; i < 2 * num_allpasses; ++i) {
+      allpass_state[i] = PreventDenormals(allpass_state[i]);
+    }
+    std::copy(&crossover[0], &crossover[num_crossovers], &crossover_[0]);
+    std::copy(
+        &allpass_state[0],
+        &allpass_state[2 * num_allpasses],
+        &allpass_state_[0]);
+  }
+
+ private:
+  struct Crossover {
+    float g;
+    float h;
+    float state[6];
+  };
+
+  static inline void Tick(
+      float g, float h, float in, float* state,
+      float* lp, float* bp, float* hp) {
+    *hp = (in - kButterworthR * state[0] - g * state[0] - state[1]) * h;
+    *bp = g * *hp + state[0];
+    state[0] = g * *hp + *bp;
+    *lp = g * *bp + state[1];
+    state[1] = g * *bp + *lp;
+  }
+
+  static const float kButterworthR;
+
+  Crossover crossover_[num_crossovers];
+  float allpass_state_[2 * num_allpasses + 2];
+
+  DISALLOW_COPY_AND_ASSIGN(MultibandCrossover);
+};
+
+template<size_t num_bands>
+const float MultibandCrossover<num_bands>::kButterworthR = 1.414213562f;
+
 }  // namespace stmlib
 
 #endif  // STMLIB_DSP_FILTER_H_
@@ -0,0 +1,142 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Kaiser-windowed sinc filters for SampleRateConverter, designed by the
+// compiler. Instead of pasting coefficients computed offline:
+//
+//   template<> struct SRC_FIR<SRC_UP, 4, 96>
+//       : public SRC_KaiserFIR<SRC_UP, 4, 96> { };
+//
+// The stopband starts at stopband / 1000 times the lower of the two rates
+// (by default, at its Nyquist frequency) and is attenuated by about
+// attenuation dB. For a given length, the transition band gets narrower as
+// the attenuation is lowered - a specification which leaves no passband does
+// not compile. KaiserFilterLength() gives the length needed for a
+// specification. Requires C++14.
+
+#ifndef STMLIB_DSP_FIR_DESIGNER_H_
+#define STMLIB_DSP_FIR_DESIGNER_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/constexpr_math.h"
+#include "stmlib/dsp/sample_rate_converter.h"
+
+namespace stmlib {
+
+constexpr double KaiserBeta(double attenuation) {
+  return attenuation > 50.0
+      ? 0.1102 * (attenuation - 8.7)
+      : (attenuation > 21.0
+          ? 0.5842 * ConstexprExp(0.4 * ConstexprLog(attenuation - 21.0)) +
+              0.07886 * (attenuation - 21.0)
+          : 0.0);
+}
+
+// Width of the transition band of a Kaiser-windowed filter, relative to the
+// sample rate.
+constexpr double KaiserTransitionWidth(double attenuation, int32_t length) {
+  return (attenuation - 7.95) / (14.36 * (length - 1));
+}
+
+// Number of taps needed for a given attenuation and transition width
+// (relative to the sample rate).
+constexpr int32_t KaiserFilterLength(double attenuation, double transition) {
+  double n = (attenuation - 7.95) / (14.36 * transition);
+  int32_t length = static_cast<int32_t>(n);
+  return length + (n > length ? 1 : 0) + 1;
+}
+
+// The impulse response is scaled to a gain of ratio when upsampling, so that
+// each phase of the polyphase filter has a unit DC gain.
+template<
+    SampleRateConversionDirection direction,
+    int32_t ratio,
+    int32_t length,
+    int32_t attenuation,
+    int32_t stopband>
+struct SRC_KaiserFIRData {
+  constexpr SRC_KaiserFIRData() : h() {
+    const double stopband_edge = stopband / (1000.0 * ratio);
+    const double cutoff = stopband_edge - 0.5 * KaiserTransitionWidth(
+        attenuation, length);
+    const double beta = KaiserBeta(attenuation);
+    const double center = 0.5 * (length - 1);
+    const double window_scale = 1.0 / ConstexprBesselI0(beta);
+    
+    double response[length] = { };
+    double sum = 0.0;
+    for (int32_t i = 0; i < length; ++i) {
+      double t = i - center;
+      double r = t / center;
+      double window = ConstexprBesselI0(beta * ConstexprSqrt(1.0 - r * r)) *
+          window_scale;
+      double x = 2.0 * kConstexprPi * cutoff * t;
+      double sinc = t == 0.0 ? 1.0 : ConstexprSin(x) / x;
+      response[i] = sinc * window;
+      sum += response[i];
+    }
+    const double gain = direction == SRC_UP ? ratio : 1.0;
+    for (int32_t i = 0; i < length; ++i) {
+      h[i] = static_cast<float>(response[i] * gain / sum);
+    }
+  }
+  
+  float h[length];
+};
+
+template<
+    SampleRateConversionDirection direction,
+    int32_t ratio,
+    int32_t length,
+    int32_t attenuation = 96,
+    int32_t stopband = 500>
+struct SRC_KaiserFIR {
+  static_assert(
+      KaiserTransitionWidth(attenuation, length) < stopband / (1000.0 * ratio),
+      "The filter is too short for this stopband attenuation and edge.");
+  
+  template<int32_t i> inline float Read() const {
+    return data_.h[i];
+  }
+  
+  static constexpr SRC_KaiserFIRData<
+      direction, ratio, length, attenuation, stopband> data_ =
+      SRC_KaiserFIRData<direction, ratio, length, attenuation, stopband>();
+};
+
+template<
+    SampleRateConversionDirection direction,
+    int32_t ratio,
+    int32_t length,
+    int32_t attenuation,
+    int32_t stopband>
+constexpr SRC_KaiserFIRData<direction, ratio, length, attenuation, stopband>
+SRC_KaiserFIR<direction, ratio, length, attenuation, stopband>::data_;
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_FIR_DESIGNER_H_
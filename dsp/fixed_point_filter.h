@@ -0,0 +1,295 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Fixed-point versions of the zero-delay-feedback filters, for targets without
+// FPU (STM32F0xx, STM32F10x).
+//
+// Samples are 16-bit. They are processed internally with 8 additional bits
+// of fractional precision (and 8 bits of headroom), and saturated on output.
+// Coefficients are Q4.28, which covers the SVF's g up to 0.45 * fs and
+// resonance down to 0.125. Products use 32x32 -> 64 bits multiplications.
+//
+// The states of the SVF grow with the resonance and with g, and exceed the
+// int32_t range with a full-scale input well below the maximum resonance. Its
+// internal signals are thus saturated at +/-2^30 (42dB above full scale), so
+// that the sum of two of them never overflows.
+//
+// The coefficients can be set from float values (once per block, with the
+// same approximations as the float filters), or directly from Q4.28 LUTs.
+
+#ifndef STMLIB_DSP_FIXED_POINT_FILTER_H_
+#define STMLIB_DSP_FIXED_POINT_FILTER_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/filter.h"
+
+namespace stmlib {
+
+enum {
+  FIXED_POINT_FILTER_COEFFICIENT_SHIFT = 28,
+  FIXED_POINT_FILTER_SIGNAL_SHIFT = 8
+};
+
+class FixedPointFilter {
+ public:
+  static inline int32_t Coefficient(float x) {
+    const float scale = static_cast<float>(
+        1L << FIXED_POINT_FILTER_COEFFICIENT_SHIFT);
+    const float max = 8.0f - 1.0f / 65536.0f;
+    x = x < max ? x : max;
+    x = x > -max ? x : -max;
+    return static_cast<int32_t>(x * scale);
+  }
+  
+  // Rounded, to avoid accumulating a DC offset in the integrators.
+  static inline int32_t Multiply(int32_t signal, int32_t coefficient) {
+    const int64_t round = 1L << (FIXED_POINT_FILTER_COEFFICIENT_SHIFT - 1);
+    return static_cast<int32_t>(
+        (static_cast<int64_t>(signal) * coefficient + round) >>
+            FIXED_POINT_FILTER_COEFFICIENT_SHIFT);
+  }
+  
+  static inline int32_t Load(int16_t x) {
+    // Multiplied rather than shifted: left-shifting a negative value is UB.
+    return static_cast<int32_t>(x) * (1 << FIXED_POINT_FILTER_SIGNAL_SHIFT);
+  }
+  
+  // Clamps the internal signals of the SVF to +/-2^30.
+  static inline int32_t Saturate(int64_t x) {
+    const int64_t limit = (static_cast<int64_t>(1) << 30) - 1;
+    return static_cast<int32_t>(x < -limit ? -limit : (x > limit ? limit : x));
+  }
+  
+  static inline int32_t SaturatingMultiply(
+      int32_t signal,
+      int32_t coefficient) {
+    const int64_t round = 1L << (FIXED_POINT_FILTER_COEFFICIENT_SHIFT - 1);
+    return Saturate(
+        (static_cast<int64_t>(signal) * coefficient + round) >>
+            FIXED_POINT_FILTER_COEFFICIENT_SHIFT);
+  }
+  
+  static inline int16_t Store(int32_t x) {
+    x >>= FIXED_POINT_FILTER_SIGNAL_SHIFT;
+    if (x < -32768) {
+      x = -32768;
+    } else if (x > 32767) {
+      x = 32767;
+    }
+    return static_cast<int16_t>(x);
+  }
+};
+
+class FixedPointDCBlocker {
+ public:
+  FixedPointDCBlocker() { }
+  ~FixedPointDCBlocker() { }
+  
+  void Init(float pole) {
+    x_ = 0;
+    y_ = 0;
+    pole_ = FixedPointFilter::Coefficient(pole);
+  }
+  
+  inline void Process(int16_t* in_out, size_t size) {
+    int32_t x = x_;
+    int32_t y = y_;
+    const int32_t pole = pole_;
+    while (size--) {
+      int32_t old_x = x;
+      x = FixedPointFilter::Load(*in_out);
+      y = FixedPointFilter::Multiply(y, pole) + x - old_x;
+      *in_out++ = FixedPointFilter::Store(y);
+    }
+    x_ = x;
+    y_ = y;
+  }
+  
+ private:
+  int32_t pole_;
+  int32_t x_;
+  int32_t y_;
+  
+  DISALLOW_COPY_AND_ASSIGN(FixedPointDCBlocker);
+};
+
+class FixedPointOnePole {
+ public:
+  FixedPointOnePole() { }
+  ~FixedPointOnePole() { }
+  
+  void Init() {
+    set_f<FREQUENCY_DIRTY>(0.01f);
+    Reset();
+  }
+  
+  void Reset() {
+    state_ = 0;
+  }
+  
+  template<FrequencyApproximation approximation>
+  inline void set_f(float f) {
+    float g = OnePole::tan<approximation>(f);
+    g_ = FixedPointFilter::Coefficient(g);
+    gi_ = FixedPointFilter::Coefficient(1.0f / (1.0f + g));
+  }
+  
+  // Set coefficients from Q4.28 LUT.
+  inline void set_g_gi(int32_t g, int32_t gi) {
+    g_ = g;
+    gi_ = gi;
+  }
+  
+  template<FilterMode mode>
+  inline void Process(int16_t* in_out, size_t size) {
+    int32_t state = state_;
+    const int32_t g = g_;
+    const int32_t gi = gi_;
+    while (size--) {
+      int32_t in = FixedPointFilter::Load(*in_out);
+      int32_t lp = FixedPointFilter::Multiply(
+          FixedPointFilter::Multiply(in, g) + state, gi);
+      state = FixedPointFilter::Multiply(in - lp, g) + lp;
+      
+      int32_t value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_HIGH_PASS) {
+        value = in - lp;
+      } else {
+        value = 0;
+      }
+      *in_out++ = FixedPointFilter::Store(value);
+    }
+    state_ = state;
+  }
+  
+ private:
+  int32_t g_;
+  int32_t gi_;
+  int32_t state_;
+  
+  DISALLOW_COPY_AND_ASSIGN(FixedPointOnePole);
+};
+
+class FixedPointSvf {
+ public:
+  FixedPointSvf() { }
+  ~FixedPointSvf() { }
+  
+  void Init() {
+    set_f_q<FREQUENCY_DIRTY>(0.01f, 100.0f);
+    Reset();
+  }
+  
+  void Reset() {
+    state_1_ = state_2_ = 0;
+  }
+  
+  // Set all parameters from Q4.28 LUT.
+  inline void set_g_r_h(int32_t g, int32_t r, int32_t h) {
+    g_ = g;
+    r_ = r;
+    h_ = h;
+  }
+  
+  // Set frequency and resonance from true units.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(float f, float resonance) {
+    float g = OnePole::tan<approximation>(f);
+    float r = 1.0f / resonance;
+    float h = 1.0f / (1.0f + r * g + g * g);
+    g_ = FixedPointFilter::Coefficient(g);
+    r_ = FixedPointFilter::Coefficient(r);
+    h_ = FixedPointFilter::Coefficient(h);
+  }
+  
+  template<FilterMode mode>
+  inline void Process(const int16_t* in, int16_t* out, size_t size) {
+    int32_t hp, bp, lp;
+    int32_t state_1 = state_1_;
+    int32_t state_2 = state_2_;
+    const int32_t g = g_;
+    const int32_t r = r_;
+    const int32_t h = h_;
+    const int64_t r_plus_g = static_cast<int64_t>(r) + g;
+    const int64_t round = 1L << (FIXED_POINT_FILTER_COEFFICIENT_SHIFT - 1);
+    const int64_t limit = (static_cast<int64_t>(1) << 32) - 1;
+    
+    while (size--) {
+      int32_t x = FixedPointFilter::Load(*in++);
+      // Before the scaling by h, this sum legitimately exceeds the saturation
+      // range when g is large, so it is computed with 64 bits - and clamped so
+      // that its product with h still fits.
+      int64_t feedback = static_cast<int64_t>(x - state_2) - (
+          (static_cast<int64_t>(state_1) * r_plus_g + round) >>
+              FIXED_POINT_FILTER_COEFFICIENT_SHIFT);
+      feedback = feedback < -limit ? -limit : (
+          feedback > limit ? limit : feedback);
+      hp = FixedPointFilter::Saturate(
+          (feedback * h + round) >> FIXED_POINT_FILTER_COEFFICIENT_SHIFT);
+      int32_t g_hp = FixedPointFilter::SaturatingMultiply(hp, g);
+      bp = FixedPointFilter::Saturate(g_hp + state_1);
+      state_1 = FixedPointFilter::Saturate(g_hp + bp);
+      int32_t g_bp = FixedPointFilter::SaturatingMultiply(bp, g);
+      lp = FixedPointFilter::Saturate(g_bp + state_2);
+      state_2 = FixedPointFilter::Saturate(g_bp + lp);
+      
+      int32_t value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_BAND_PASS) {
+        value = bp;
+      } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+        value = FixedPointFilter::SaturatingMultiply(bp, r);
+      } else {
+        value = hp;
+      }
+      *out++ = FixedPointFilter::Store(value);
+    }
+    state_1_ = state_1;
+    state_2_ = state_2;
+  }
+  
+  inline int32_t g() const { return g_; }
+  inline int32_t r() const { return r_; }
+  inline int32_t h() const { return h_; }
+  
+ private:
+  int32_t g_;
+  int32_t r_;
+  int32_t h_;
+  
+  int32_t state_1_;
+  int32_t state_2_;
+  
+  DISALLOW_COPY_AND_ASSIGN(FixedPointSvf);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_FIXED_POINT_FILTER_H_
@@ -0,0 +1,333 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Sample rate converters by powers of two, made of a cascade of 2x half-band
+// stages.
+//
+// Every other tap of a half-band filter is zero, except the center tap which
+// is 0.5. Thus, a 2x upsampler computes its even outputs with the 2m non-zero
+// side taps, and its odd outputs are delayed input samples - and a 2x
+// downsampler adds half of a delayed odd input to the filtered even inputs.
+// The side taps are symmetric: only m of them are stored, and they are read
+// through the mirror argument of Accumulator.
+//
+// Each stage only has to reject the images of the band below 0.4 times the
+// base rate, so the transition band gets wider - and the filter shorter - as
+// the rate rises. Images are rejected by 95 dB or more. An 8x conversion takes
+// 32 + 2 x 12 + 4 x 10 = 96 MACs per base rate sample, while a single FIR with
+// the same specifications would need about 480.
+
+#ifndef STMLIB_DSP_HALF_BAND_RESAMPLER_H_
+#define STMLIB_DSP_HALF_BAND_RESAMPLER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+
+#include "stmlib/dsp/sample_rate_converter.h"
+
+namespace stmlib {
+
+const size_t kHalfBandBlockSize = 32;
+
+// Stores the first half of the non-zero side taps, normalized so that they
+// sum to 1 (the gain of the upsampler's even outputs).
+template<int32_t num_taps>
+struct HalfBandFIR { };
+
+template<>
+struct HalfBandFIR<32> {
+  template<int32_t i> inline float Read() const {
+    const float h[] = {
+      -9.243740582e-06,  6.963602983e-05, -2.398946298e-04,  6.223111014e-04,
+      -1.370259028e-03,  2.698157284e-03, -4.891166746e-03,  8.318115437e-03,
+      -1.345687339e-02,  2.095369203e-02, -3.176827560e-02,  4.754442007e-02,
+      -7.165795305e-02,  1.128269918e-01, -2.032047780e-01,  6.335651205e-01,
+    };
+    return h[i];
+  }
+};
+
+template<>
+struct HalfBandFIR<12> {
+  template<int32_t i> inline float Read() const {
+    const float h[] = {
+      -1.621206938e-05,  1.208802093e-03, -9.983228007e-03,  4.408870335e-02,
+      -1.467698941e-01,  6.114718287e-01,
+    };
+    return h[i];
+  }
+};
+
+template<>
+struct HalfBandFIR<10> {
+  template<int32_t i> inline float Read() const {
+    const float h[] = {
+       7.645842386e-06, -1.770067435e-03,  2.102396507e-02, -1.149329912e-01,
+       5.956714477e-01,
+    };
+    return h[i];
+  }
+};
+
+template<>
+struct HalfBandFIR<8> {
+  template<int32_t i> inline float Read() const {
+    const float h[] = {
+      -4.093727159e-05,  8.208285761e-03, -8.727478919e-02,  5.791074407e-01,
+    };
+    return h[i];
+  }
+};
+
+// Number of non-zero side taps of the stage converting between rate / 2 and
+// rate times the base rate.
+template<int32_t rate>
+struct HalfBandStageTaps {
+  enum {
+    value = rate <= 2 ? 32 : (rate <= 4 ? 12 : (rate <= 8 ? 10 : 8))
+  };
+};
+
+template<SampleRateConversionDirection direction, int32_t num_taps>
+class HalfBandConverter { };
+
+// The delays are expressed in samples at the higher of the two rates.
+template<int32_t num_taps>
+class HalfBandConverter<SRC_UP, num_taps> {
+ private:
+  enum {
+    N = num_taps,
+    M = num_taps / 2
+  };
+
+ public:
+  HalfBandConverter() { }
+  ~HalfBandConverter() { }
+
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * N], 0);
+    x_ptr_ = &x_[N - 1];
+#if STMLIB_SRC_VECTORIZED
+    CoefficientTable<N, N> table;
+    table(HalfBandFIR<N>(), h_);
+#endif  // STMLIB_SRC_VECTORIZED
+  }
+
+  inline int32_t delay() const { return N - 1; }
+
+  inline void Process(const float* in, float* out, size_t input_size) {
+    while (input_size--) {
+      x_ptr_[0] = x_ptr_[N] = *in++;
+      --x_ptr_;
+      if (x_ptr_ < x_) {
+        x_ptr_ += N;
+      }
+      *out++ = Filter(&x_ptr_[1]);
+      *out++ = x_ptr_[M];
+    }
+  }
+
+ private:
+  inline float Filter(const float* x) const {
+#if STMLIB_SRC_VECTORIZED
+    return DotProduct<N>(x, h_);
+#else
+    Accumulator<N, 1, 1, N> accumulator;
+    return accumulator(x, HalfBandFIR<N>());
+#endif  // STMLIB_SRC_VECTORIZED
+  }
+
+#if STMLIB_SRC_VECTORIZED
+  float h_[N];
+#endif  // STMLIB_SRC_VECTORIZED
+  float x_[2 * N];
+  float* x_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(HalfBandConverter);
+};
+
+// The odd input samples are stored in a second circular buffer, sharing the
+// read/write position of the first one.
+template<int32_t num_taps>
+class HalfBandConverter<SRC_DOWN, num_taps> {
+ private:
+  enum {
+    N = num_taps,
+    M = num_taps / 2
+  };
+
+ public:
+  HalfBandConverter() { }
+  ~HalfBandConverter() { }
+
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * N], 0);
+    std::fill(&odd_[0], &odd_[2 * N], 0);
+    x_ptr_ = &x_[N - 1];
+#if STMLIB_SRC_VECTORIZED
+    CoefficientTable<N, N> table;
+    table(HalfBandFIR<N>(), h_);
+#endif  // STMLIB_SRC_VECTORIZED
+  }
+
+  inline int32_t delay() const { return N - 1; }
+
+  // input_size must be even.
+  inline void Process(const float* in, float* out, size_t input_size) {
+    while (input_size) {
+      float* odd = &odd_[x_ptr_ - x_];
+      x_ptr_[0] = x_ptr_[N] = in[0];
+      odd[0] = odd[N] = in[1];
+      *out++ = 0.5f * (Filter(x_ptr_) + odd[M]);
+      --x_ptr_;
+      if (x_ptr_ < x_) {
+        x_ptr_ += N;
+      }
+      in += 2;
+      input_size -= 2;
+    }
+  }
+
+ private:
+  inline float Filter(const float* x) const {
+#if STMLIB_SRC_VECTORIZED
+    return DotProduct<N>(x, h_);
+#else
+    Accumulator<N, 1, 1, N> accumulator;
+    return accumulator(x, HalfBandFIR<N>());
+#endif  // STMLIB_SRC_VECTORIZED
+  }
+
+#if STMLIB_SRC_VECTORIZED
+  float h_[N];
+#endif  // STMLIB_SRC_VECTORIZED
+  float x_[2 * N];
+  float odd_[2 * N];
+  float* x_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(HalfBandConverter);
+};
+
+// One stage of the cascade, converting between rate / 2 and rate times the
+// base rate, followed by the remaining stages. The intermediate signal is
+// processed by blocks of at most kHalfBandBlockSize samples at the lower rate.
+template<
+    SampleRateConversionDirection direction,
+    int32_t ratio,
+    int32_t rate,
+    bool last = direction == SRC_UP ? rate == ratio : rate == 2>
+class HalfBandCascade {
+ private:
+  enum {
+    next_rate = direction == SRC_UP ? 2 * rate : rate / 2
+  };
+
+ public:
+  HalfBandCascade() { }
+  ~HalfBandCascade() { }
+
+  inline void Init() {
+    stage_.Init();
+    next_.Init();
+  }
+
+  inline int32_t delay() const {
+    return stage_.delay() * (ratio / rate) + next_.delay();
+  }
+
+  inline void Process(const float* in, float* out, size_t input_size) {
+    if (direction == SRC_UP) {
+      while (input_size) {
+        size_t size = std::min(input_size, kHalfBandBlockSize);
+        stage_.Process(in, buffer_, size);
+        next_.Process(buffer_, out, 2 * size);
+        in += size;
+        out += size * 2 * ratio / rate;
+        input_size -= size;
+      }
+    } else {
+      while (input_size) {
+        size_t size = std::min(input_size, 2 * kHalfBandBlockSize);
+        stage_.Process(in, buffer_, size);
+        next_.Process(buffer_, out, size / 2);
+        in += size;
+        out += size / rate;
+        input_size -= size;
+      }
+    }
+  }
+
+ private:
+  HalfBandConverter<direction, HalfBandStageTaps<rate>::value> stage_;
+  HalfBandCascade<direction, ratio, next_rate> next_;
+  float buffer_[2 * kHalfBandBlockSize];
+
+  DISALLOW_COPY_AND_ASSIGN(HalfBandCascade);
+};
+
+template<SampleRateConversionDirection direction, int32_t ratio, int32_t rate>
+class HalfBandCascade<direction, ratio, rate, true> {
+ public:
+  HalfBandCascade() { }
+  ~HalfBandCascade() { }
+
+  inline void Init() { stage_.Init(); }
+  inline int32_t delay() const { return stage_.delay() * (ratio / rate); }
+  inline void Process(const float* in, float* out, size_t input_size) {
+    stage_.Process(in, out, input_size);
+  }
+
+ private:
+  HalfBandConverter<direction, HalfBandStageTaps<rate>::value> stage_;
+
+  DISALLOW_COPY_AND_ASSIGN(HalfBandCascade);
+};
+
+// Same interface as SampleRateConverter, for ratios of 2, 4, 8, 16... The
+// delay is expressed in samples at the higher rate. When downsampling,
+// input_size must be a multiple of ratio.
+template<SampleRateConversionDirection direction, int32_t ratio>
+class HalfBandSampleRateConverter {
+ public:
+  HalfBandSampleRateConverter() { }
+  ~HalfBandSampleRateConverter() { }
+
+  inline void Init() { cascade_.Init(); }
+  inline int32_t delay() const { return cascade_.delay(); }
+  inline void Process(const float* in, float* out, size_t input_size) {
+    cascade_.Process(in, out, input_size);
+  }
+
+ private:
+  HalfBandCascade<direction, ratio, direction == SRC_UP ? 2 : ratio> cascade_;
+
+  DISALLOW_COPY_AND_ASSIGN(HalfBandSampleRateConverter);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_HALF_BAND_RESAMPLER_H_
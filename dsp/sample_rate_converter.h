@@ -25,6 +25,21 @@
 // -----------------------------------------------------------------------------
 //
 // Sample rate converter.
+//
+// The FIR dot products are computed by fully unrolled scalar multiply-adds,
+// which suit Cortex-M. On targets with a vector unit, they are computed by
+// SIMD vectors from a table of the coefficients built in Init() - the outputs
+// are the same up to the rounding of the summation order. Downsamplers only
+// store half of their symmetric filter, and add the two samples sharing each
+// coefficient before the multiplication. Define STMLIB_SRC_VECTORIZED to 0 or
+// 1 to override this choice.
+//
+// Upsamplers only have filter_size / ratio taps per phase. For the usual sizes
+// (2x/32, 4x/48), the unrolled code with its coefficients folded in is faster
+// than the vectors, which compute the ratio phases at once and must load the
+// coefficients - so upsamplers remain scalar unless STMLIB_SRC_VECTORIZED_UP is
+// defined to 1. This pays off when the phases fill a whole vector (8x with
+// AVX).
 
 #ifndef STMLIB_DSP_SAMPLE_RATE_CONVERTER_H_
 #define STMLIB_DSP_SAMPLE_RATE_CONVERTER_H_
@@ -32,6 +47,17 @@
 #include "stmlib/stmlib.h"
 
 #include <algorithm>
+#include <cstring>
+
+#include "stmlib/dsp/simd.h"
+
+#ifndef STMLIB_SRC_VECTORIZED
+#define STMLIB_SRC_VECTORIZED (STMLIB_SIMD_MAX_WIDTH >= 4)
+#endif  // STMLIB_SRC_VECTORIZED
+
+#ifndef STMLIB_SRC_VECTORIZED_UP
+#define STMLIB_SRC_VECTORIZED_UP 0
+#endif  // STMLIB_SRC_VECTORIZED_UP
 
 namespace stmlib {
 
@@ -148,6 +174,76 @@ struct PolyphaseStage<K, mirror, 0> {
   inline void operator()(float* &y, const T& x, const IR& h) const { }
 };
 
+// Copies the length coefficients of a filter (of which only the first half is
+// stored when mirror is non-zero) into an array.
+template<int32_t length, int32_t mirror, int32_t i = 0>
+struct CoefficientTable {
+  enum {
+    h_index = mirror != 0 && i >= mirror / 2 ? mirror - 1 - i : i
+  };
+  
+  template<typename IR>
+  inline void operator()(const IR& h, float* destination) const {
+    destination[i] = h.template Read<h_index>();
+    CoefficientTable<length, mirror, i + 1> next;
+    next(h, destination);
+  }
+};
+
+template<int32_t length, int32_t mirror>
+struct CoefficientTable<length, mirror, length> {
+  template<typename IR>
+  inline void operator()(const IR& h, float* destination) const { }
+};
+
+// Vectorized counterpart of Accumulator<N, 1, 1>. Two accumulators are used
+// to halve the length of the dependency chain.
+template<int32_t N>
+inline float DotProduct(const float* x, const float* h) {
+  typedef typename FloatVector<SimdWidth<N>::value>::type Vector;
+  const int32_t width = SimdWidth<N>::value;
+  Vector a = Vector();
+  Vector b = Vector();
+  int32_t i = 0;
+  for (; i + 2 * width <= N; i += 2 * width) {
+    a += SimdLoad<Vector>(x + i) * SimdLoad<Vector>(h + i);
+    b += SimdLoad<Vector>(x + i + width) * SimdLoad<Vector>(h + i + width);
+  }
+  if (i < N) {
+    a += SimdLoad<Vector>(x + i) * SimdLoad<Vector>(h + i);
+  }
+  return SimdSum(a + b);
+}
+
+// Dot product of x with a symmetric filter of N taps, of which h stores the
+// first (N + 1) / 2: the samples sharing a coefficient are added first, which
+// halves the multiplications and the coefficient loads.
+template<int32_t N>
+inline float SymmetricDotProduct(const float* x, const float* h) {
+  typedef typename FloatVector<SimdWidth<N / 2>::value>::type Vector;
+  const int32_t width = SimdWidth<N / 2>::value;
+  const float* mirror = x + N - width;
+  Vector a = Vector();
+  Vector b = Vector();
+  int32_t i = 0;
+  for (; i + 2 * width <= N / 2; i += 2 * width) {
+    a += (SimdLoad<Vector>(x + i) +
+          SimdReverse(SimdLoad<Vector>(mirror - i))) * SimdLoad<Vector>(h + i);
+    b += (SimdLoad<Vector>(x + i + width) +
+          SimdReverse(SimdLoad<Vector>(mirror - i - width))) *
+        SimdLoad<Vector>(h + i + width);
+  }
+  if (i < N / 2) {
+    a += (SimdLoad<Vector>(x + i) +
+          SimdReverse(SimdLoad<Vector>(mirror - i))) * SimdLoad<Vector>(h + i);
+  }
+  float sum = SimdSum(a + b);
+  if (N & 1) {
+    sum += x[N / 2] * h[N / 2];
+  }
+  return sum;
+}
+
 template<
     SampleRateConversionDirection direction,
     int32_t ratio,
@@ -196,6 +292,64 @@ class SampleRateConverter<SRC_UP, ratio, filter_size> {
   SampleRateConverter() { }
   ~SampleRateConverter() { }
 
+#if STMLIB_SRC_VECTORIZED_UP
+
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * N], 0);
+    x_ptr_ = &x_[N - 1];
+    
+    // Phase k uses the coefficients k, k + K, k + 2K... so the coefficients
+    // for tap i of all phases are contiguous, and the K phases are computed
+    // at once by the lanes of the vectors.
+    CoefficientTable<filter_size, filter_size> table;
+    table(SRC_FIR<SRC_UP, ratio, filter_size>(), h_);
+  };
+
+  inline int32_t delay() const { return filter_size / ratio / 2; }
+
+  // The history is a circular buffer in which each sample is written twice,
+  // so that the last N samples (most recent first) are always contiguous.
+  inline void Process(const float* in, float* out, size_t input_size) {
+    while (input_size--) {
+      x_ptr_[0] = x_ptr_[N] = *in++;
+      const float* x = x_ptr_;
+      --x_ptr_;
+      if (x_ptr_ < x_) {
+        x_ptr_ += N;
+      }
+      Phases y = LoadPhases(0) * x[0];
+      if (N > 1) {
+        Phases z = LoadPhases(1) * x[1];
+        int32_t i = 2;
+        for (; i + 1 < N; i += 2) {
+          y = y + LoadPhases(i) * x[i];
+          z = z + LoadPhases(i + 1) * x[i + 1];
+        }
+        if (i < N) {
+          y = y + LoadPhases(i) * x[i];
+        }
+        y = y + z;
+      }
+      memcpy(out, &y, sizeof(y));
+      out += K;
+    }
+  }
+  
+ private:
+  typedef FloatLanes<K> Phases;
+  
+  inline Phases LoadPhases(int32_t i) const {
+    Phases h;
+    memcpy(&h, &h_[i * K], sizeof(h));
+    return h;
+  }
+  
+  float h_[filter_size];
+  float x_[2 * N];
+  float* x_ptr_;
+
+#else
+
   inline void Init() {
     std::fill(&x_[0], &x_[N], 0);
   };
@@ -217,6 +371,8 @@ class SampleRateConverter<SRC_UP, ratio, filter_size> {
  private:
   float x_[N];
 
+#endif  // STMLIB_SRC_VECTORIZED_UP
+
   DISALLOW_COPY_AND_ASSIGN(SampleRateConverter);
 };
 
@@ -235,6 +391,10 @@ class SampleRateConverter<SRC_DOWN, ratio, filter_size> {
   inline void Init() {
     std::fill(&x_[0], &x_[2 * N], 0);
     x_ptr_ = &x_[N - 1];
+#if STMLIB_SRC_VECTORIZED
+    CoefficientTable<(filter_size + 1) / 2, filter_size> table;
+    table(SRC_FIR<SRC_DOWN, ratio, filter_size>(), h_);
+#endif  // STMLIB_SRC_VECTORIZED
   };
 
   inline int32_t delay() const { return filter_size / 2; }
@@ -246,14 +406,12 @@ class SampleRateConverter<SRC_DOWN, ratio, filter_size> {
       return;
     }
 
-    SRC_FIR<SRC_DOWN, ratio, filter_size> ir;
     if (input_size >= 8 * filter_size) {
       std::copy(&in[0], &in[N], &x_[N - 1]);
       
       // Generate the samples which require access to the history buffer.
       for (int32_t i = 0; i < N; i += ratio) {
-        Accumulator<N, -1, 1, filter_size> accumulator;
-        *out++ = accumulator(&x_[N - 1 + i], ir);
+        *out++ = Backward(&x_[N - 1 + i]);
         in += ratio;
         input_size -= ratio;
       }
@@ -263,16 +421,14 @@ class SampleRateConverter<SRC_DOWN, ratio, filter_size> {
       // is small, we can unroll the summation loop.
       if ((input_size / ratio) & 1) {
         while (input_size) {
-          Accumulator<N, -1, 1, filter_size> accumulator;
-          *out++ = accumulator(in, ir);
+          *out++ = Backward(in);
           input_size -= ratio;
           in += ratio;
         }
       } else {
         while (input_size) {
-          Accumulator<N, -1, 1, filter_size> accumulator;
-          *out++ = accumulator(in, ir);
-          *out++ = accumulator(in + ratio, ir);
+          *out++ = Backward(in);
+          *out++ = Backward(in + ratio);
           input_size -= 2 * ratio;
           in += 2 * ratio;
         }
@@ -292,19 +448,233 @@ class SampleRateConverter<SRC_DOWN, ratio, filter_size> {
         }
         input_size -= ratio;
 
-        Accumulator<N, 1, 1, filter_size> accumulator;
-        *out++ = accumulator(&x_ptr_[1], ir);
+        *out++ = Forward(&x_ptr_[1]);
       }
     }
   }
  
  private:
+  // Sum of x[-i] * h[i] and of x[i] * h[i]. The filter is symmetric, so the
+  // former is also the dot product of x[-N + 1..0] with h.
+  inline float Backward(const float* x) const {
+#if STMLIB_SRC_VECTORIZED
+    return SymmetricDotProduct<N>(x - N + 1, h_);
+#else
+    Accumulator<N, -1, 1, filter_size> accumulator;
+    return accumulator(x, SRC_FIR<SRC_DOWN, ratio, filter_size>());
+#endif  // STMLIB_SRC_VECTORIZED
+  }
+  
+  inline float Forward(const float* x) const {
+#if STMLIB_SRC_VECTORIZED
+    return SymmetricDotProduct<N>(x, h_);
+#else
+    Accumulator<N, 1, 1, filter_size> accumulator;
+    return accumulator(x, SRC_FIR<SRC_DOWN, ratio, filter_size>());
+#endif  // STMLIB_SRC_VECTORIZED
+  }
+  
+#if STMLIB_SRC_VECTORIZED
+  float h_[(N + 1) / 2];
+#endif  // STMLIB_SRC_VECTORIZED
   float x_[2 * N];
   float* x_ptr_;
 
   DISALLOW_COPY_AND_ASSIGN(SampleRateConverter);
 };
 
+// Multi-channel variants, processing frames of num_channels interleaved
+// samples - input_size is a number of frames. The history of all channels is
+// stored in a single circular buffer of frames, and each coefficient is
+// loaded once and applied to all the channels. The coefficients are thus read
+// from a table built in Init(), whatever the target.
+
+// Computes the num_channels dot products of N frames (most recent first) with
+// the coefficients h, and writes them to the frame y.
+template<int32_t N, int32_t num_channels>
+inline void FrameDotProduct(const float* x, const float* h, float* y) {
+  typedef FloatLanes<num_channels> Frame;
+  Frame a, b, frame;
+  memcpy(&a, x, sizeof(Frame));
+  memcpy(&b, x + num_channels, sizeof(Frame));
+  a = a * h[0];
+  b = b * h[1];
+  int32_t i = 2;
+  for (; i + 1 < N; i += 2) {
+    memcpy(&frame, x + i * num_channels, sizeof(Frame));
+    a = a + frame * h[i];
+    memcpy(&frame, x + (i + 1) * num_channels, sizeof(Frame));
+    b = b + frame * h[i + 1];
+  }
+  if (i < N) {
+    memcpy(&frame, x + i * num_channels, sizeof(Frame));
+    a = a + frame * h[i];
+  }
+  a = a + b;
+  memcpy(y, &a, sizeof(Frame));
+}
+
+template<
+    SampleRateConversionDirection direction,
+    int32_t ratio,
+    int32_t filter_size,
+    int32_t num_channels>
+class MultiChannelSampleRateConverter { };
+
+template<int32_t filter_size, int32_t num_channels>
+class MultiChannelSampleRateConverter<SRC_UP, 1, filter_size, num_channels> {
+ public:
+  MultiChannelSampleRateConverter() { }
+  ~MultiChannelSampleRateConverter() { }
+  
+  inline void Init() { }
+  inline int32_t delay() const { return 0; }
+  inline void Process(const float* in, float* out, size_t input_size) {
+    std::copy(&in[0], &in[input_size * num_channels], &out[0]);
+  }
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MultiChannelSampleRateConverter);
+};
+
+template<int32_t filter_size, int32_t num_channels>
+class MultiChannelSampleRateConverter<SRC_DOWN, 1, filter_size, num_channels> {
+ public:
+  MultiChannelSampleRateConverter() { }
+  ~MultiChannelSampleRateConverter() { }
+  
+  inline void Init() { }
+  inline int32_t delay() const { return 0; }
+  inline void Process(const float* in, float* out, size_t input_size) {
+    std::copy(&in[0], &in[input_size * num_channels], &out[0]);
+  }
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MultiChannelSampleRateConverter);
+};
+
+template<int32_t ratio, int32_t filter_size, int32_t num_channels>
+class MultiChannelSampleRateConverter<
+    SRC_UP, ratio, filter_size, num_channels> {
+ private:
+  enum {
+    N = filter_size / ratio,
+    K = ratio,
+    C = num_channels
+  };
+ 
+ public:
+  MultiChannelSampleRateConverter() { }
+  ~MultiChannelSampleRateConverter() { }
+
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * N * C], 0);
+    x_ptr_ = &x_[(N - 1) * C];
+    CoefficientTable<filter_size, filter_size> table;
+    table(SRC_FIR<SRC_UP, ratio, filter_size>(), h_);
+  };
+
+  inline int32_t delay() const { return filter_size / ratio / 2; }
+
+  // Each coefficient vector h_[i * K]..h_[i * K + K - 1] (the i-th coefficient
+  // of all phases) is loaded once and applied to the C channels of frame i.
+  // The K phases of each channel are computed by the lanes of the vectors,
+  // and transposed into frames at the end.
+  inline void Process(const float* in, float* out, size_t input_size) {
+    typedef FloatLanes<K> Phases;
+    while (input_size--) {
+      float* x = x_ptr_;
+      std::copy(&in[0], &in[C], &x[0]);
+      std::copy(&in[0], &in[C], &x[N * C]);
+      in += C;
+      
+      Phases y[C];
+      Phases h;
+      memcpy(&h, &h_[0], sizeof(Phases));
+      STMLIB_UNROLL
+      for (int32_t c = 0; c < C; ++c) {
+        y[c] = h * x[c];
+      }
+      for (int32_t i = 1; i < N; ++i) {
+        memcpy(&h, &h_[i * K], sizeof(Phases));
+        const float* frame = &x[i * C];
+        STMLIB_UNROLL
+        for (int32_t c = 0; c < C; ++c) {
+          y[c] = y[c] + h * frame[c];
+        }
+      }
+      
+      float phases[C][K];
+      memcpy(phases, y, sizeof(y));
+      for (int32_t k = 0; k < K; ++k) {
+        for (int32_t c = 0; c < C; ++c) {
+          *out++ = phases[c][k];
+        }
+      }
+      
+      x -= C;
+      if (x < x_) {
+        x += N * C;
+      }
+      x_ptr_ = x;
+    }
+  }
+  
+ private:
+  float h_[filter_size];
+  float x_[2 * N * C];
+  float* x_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(MultiChannelSampleRateConverter);
+};
+
+template<int32_t ratio, int32_t filter_size, int32_t num_channels>
+class MultiChannelSampleRateConverter<
+    SRC_DOWN, ratio, filter_size, num_channels> {
+ private:
+  enum {
+    N = filter_size,
+    C = num_channels
+  };
+ 
+ public:
+  MultiChannelSampleRateConverter() { }
+  ~MultiChannelSampleRateConverter() { }
+
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * N * C], 0);
+    x_ptr_ = &x_[(N - 1) * C];
+    CoefficientTable<filter_size, filter_size> table;
+    table(SRC_FIR<SRC_DOWN, ratio, filter_size>(), h_);
+  };
+
+  inline int32_t delay() const { return filter_size / 2; }
+
+  // input_size must be a multiple of ratio.
+  inline void Process(const float* in, float* out, size_t input_size) {
+    while (input_size) {
+      for (int32_t i = 0; i < ratio; ++i) {
+        std::copy(&in[0], &in[C], &x_ptr_[0]);
+        std::copy(&in[0], &in[C], &x_ptr_[N * C]);
+        in += C;
+        x_ptr_ -= C;
+        if (x_ptr_ < x_) {
+          x_ptr_ += N * C;
+        }
+      }
+      input_size -= ratio;
+
+      FrameDotProduct<N, C>(&x_ptr_[C], h_, out);
+      out += C;
+    }
+  }
+ 
+ private:
+  float h_[N];
+  float x_[2 * N * C];
+  float* x_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(MultiChannelSampleRateConverter);
+};
+
 }  // namespace stmlib
 
 #endif  // STMLIB_DSP_SAMPLE_RATE_CONVERTER_H_
@@ -0,0 +1,191 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Short vector types for block processing.
+//
+// This relies on the GCC vector extensions, so the same code is compiled to
+// SSE/AVX instructions on the host, to NEON on the parts which have it, and
+// to plain scalar code on Cortex-M.
+
+#ifndef STMLIB_DSP_SIMD_H_
+#define STMLIB_DSP_SIMD_H_
+
+#include "stmlib/stmlib.h"
+
+#include <cstring>
+
+#if defined(__AVX__)
+#define STMLIB_SIMD_MAX_WIDTH 8
+#elif defined(__SSE__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define STMLIB_SIMD_MAX_WIDTH 4
+#else
+#define STMLIB_SIMD_MAX_WIDTH 1
+#endif  // __AVX__
+
+// Complete unrolling of the short loops over the native vectors, which -O2
+// does not always do.
+#if defined(__clang__)
+#define STMLIB_UNROLL _Pragma("unroll")
+#elif __GNUC__ >= 8
+#define STMLIB_UNROLL _Pragma("GCC unroll 16")
+#else
+#define STMLIB_UNROLL
+#endif  // __clang__
+
+namespace stmlib {
+
+template<size_t width>
+struct FloatVector {
+  typedef float type __attribute__((vector_size(width * sizeof(float))));
+};
+
+template<>
+struct FloatVector<1> {
+  typedef float type;
+};
+
+// Widest vector usable to process n contiguous lanes.
+template<size_t n>
+struct SimdWidth {
+  enum {
+    value = (STMLIB_SIMD_MAX_WIDTH >= 8 && n % 8 == 0) ? 8 :
+        ((STMLIB_SIMD_MAX_WIDTH >= 4 && n % 4 == 0) ? 4 : 1)
+  };
+};
+
+// Unaligned loads and stores. memcpy is turned into a single vector move.
+template<typename V>
+inline V SimdLoad(const float* source) {
+  V v;
+  memcpy(&v, source, sizeof(V));
+  return v;
+}
+
+template<typename V>
+inline void SimdStore(float* destination, V v) {
+  memcpy(destination, &v, sizeof(V));
+}
+
+template<typename V>
+inline V SimdSplat(float x) {
+  return V() + x;
+}
+
+// Sum of the lanes.
+template<typename V>
+inline float SimdSum(V v) {
+  float x[sizeof(V) / sizeof(float)];
+  memcpy(x, &v, sizeof(V));
+  float sum = x[0];
+  for (size_t i = 1; i < sizeof(V) / sizeof(float); ++i) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+// n interleaved channels, processed by as many native vectors as needed. This
+// makes it possible to run scalar code (filters, FFT passes) on several
+// channels at once, by substituting this type to float for the data. The
+// buffers viewed as arrays of FloatLanes<n> must be aligned on the native
+// vector size.
+template<size_t n>
+struct FloatLanes {
+  enum {
+    width = SimdWidth<n>::value,
+    count = n / width
+  };
+  typedef typename FloatVector<width>::type Vector;
+  
+  Vector v[count];
+};
+
+template<size_t n>
+inline FloatLanes<n> operator+(const FloatLanes<n>& a, const FloatLanes<n>& b) {
+  FloatLanes<n> r;
+  STMLIB_UNROLL
+  for (size_t i = 0; i < FloatLanes<n>::count; ++i) {
+    r.v[i] = a.v[i] + b.v[i];
+  }
+  return r;
+}
+
+template<size_t n>
+inline FloatLanes<n> operator-(const FloatLanes<n>& a, const FloatLanes<n>& b) {
+  FloatLanes<n> r;
+  STMLIB_UNROLL
+  for (size_t i = 0; i < FloatLanes<n>::count; ++i) {
+    r.v[i] = a.v[i] - b.v[i];
+  }
+  return r;
+}
+
+template<size_t n>
+inline FloatLanes<n> operator*(const FloatLanes<n>& a, float b) {
+  FloatLanes<n> r;
+  STMLIB_UNROLL
+  for (size_t i = 0; i < FloatLanes<n>::count; ++i) {
+    r.v[i] = a.v[i] * b;
+  }
+  return r;
+}
+
+// Lane reversal, for butterflies and symmetric filters which walk an array
+// backwards.
+inline float SimdReverse(float v) {
+  return v;
+}
+
+#if STMLIB_SIMD_MAX_WIDTH >= 4
+
+inline FloatVector<4>::type SimdReverse(FloatVector<4>::type v) {
+#ifdef __clang__
+  return __builtin_shufflevector(v, v, 3, 2, 1, 0);
+#else
+  typedef int32_t Mask __attribute__((vector_size(16)));
+  const Mask mask = { 3, 2, 1, 0 };
+  return __builtin_shuffle(v, mask);
+#endif  // __clang__
+}
+
+#endif  // STMLIB_SIMD_MAX_WIDTH >= 4
+
+#if STMLIB_SIMD_MAX_WIDTH >= 8
+
+inline FloatVector<8>::type SimdReverse(FloatVector<8>::type v) {
+#ifdef __clang__
+  return __builtin_shufflevector(v, v, 7, 6, 5, 4, 3, 2, 1, 0);
+#else
+  typedef int32_t Mask __attribute__((vector_size(32)));
+  const Mask mask = { 7, 6, 5, 4, 3, 2, 1, 0 };
+  return __builtin_shuffle(v, mask);
+#endif  // __clang__
+}
+
+#endif  // STMLIB_SIMD_MAX_WIDTH >= 8
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_SIMD_H_
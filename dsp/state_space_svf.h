@@ -0,0 +1,213 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Block state-space formulation of the zero-delay-feedback SVF.
+//
+// The filter is linear, so block_size consecutive outputs are a linear
+// function of the state at the beginning of the block and of the
+// block_size inputs: y = M.s + T.x, with T a lower triangular Toeplitz matrix
+// made of the first taps of the impulse response. Similarly, the state at the
+// end of the block is A^block_size.s + B.x. Only the 2x2 update of the state
+// is serial - everything else is made of independent multiply-adds which
+// fill the vector lanes, even for a single filter. Useful for long blocks
+// (offline rendering, large host buffers).
+//
+// The output is the same as Svf::Process<mode>, within rounding errors.
+
+#ifndef STMLIB_DSP_STATE_SPACE_SVF_H_
+#define STMLIB_DSP_STATE_SPACE_SVF_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+// The matrices depend on the output picked by mode, so the mode is a
+// template argument of the class rather than of Process(). block_size must be
+// a power of 2 greater than 1, for the lanes of Vector to be indexable.
+template<FilterMode mode, size_t block_size = 4>
+class StateSpaceSvf {
+ private:
+  STATIC_ASSERT(
+      block_size > 1 && (block_size & (block_size - 1)) == 0,
+      block_size_must_be_a_power_of_2_greater_than_1);
+  
+  typedef typename FloatVector<block_size>::type Vector;
+
+ public:
+  StateSpaceSvf() { }
+  ~StateSpaceSvf() { }
+  
+  void Init() {
+    set_f_q<FREQUENCY_DIRTY>(0.01f, 100.0f);
+    Reset();
+  }
+  
+  void Reset() {
+    state_1_ = state_2_ = 0.0f;
+  }
+  
+  // Set all parameters from LUT.
+  inline void set_g_r_h(float g, float r, float h) {
+    g_ = g;
+    r_ = r;
+    h_ = h;
+    Precompute();
+  }
+  
+  // Set frequency and resonance from true units.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(float f, float resonance) {
+    g_ = OnePole::tan<approximation>(f);
+    r_ = 1.0f / resonance;
+    h_ = 1.0f / (1.0f + r_ * g_ + g_ * g_);
+    Precompute();
+  }
+  
+  inline void Process(const float* in, float* out, size_t size) {
+    float state_1 = state_1_;
+    float state_2 = state_2_;
+    
+    while (size >= block_size) {
+      const Vector x = SimdLoad<Vector>(in);
+      
+      Vector y = m_1_ * state_1 + m_2_ * state_2;
+      for (size_t j = 0; j < block_size; ++j) {
+        y += t_[j] * x[j];
+      }
+      SimdStore(out, y);
+      
+      const Vector p_1 = b_1_ * x;
+      const Vector p_2 = b_2_ * x;
+      float next_1 = a_11_ * state_1 + a_12_ * state_2;
+      float next_2 = a_21_ * state_1 + a_22_ * state_2;
+      for (size_t j = 0; j < block_size; ++j) {
+        next_1 += p_1[j];
+        next_2 += p_2[j];
+      }
+      state_1 = next_1;
+      state_2 = next_2;
+      
+      in += block_size;
+      out += block_size;
+      size -= block_size;
+    }
+    
+    while (size--) {
+      *out++ = Tick(*in++, &state_1, &state_2);
+    }
+    
+    state_1_ = PreventDenormals(state_1);
+    state_2_ = PreventDenormals(state_2);
+  }
+  
+  inline float g() const { return g_; }
+  inline float r() const { return r_; }
+  inline float h() const { return h_; }
+  
+ private:
+  // One step of the serial recursion, as in Svf::Process.
+  inline float Tick(float in, float* state_1, float* state_2) const {
+    float hp, bp, lp;
+    hp = (in - r_ * *state_1 - g_ * *state_1 - *state_2) * h_;
+    bp = g_ * hp + *state_1;
+    *state_1 = g_ * hp + bp;
+    lp = g_ * bp + *state_2;
+    *state_2 = g_ * bp + lp;
+    
+    if (mode == FILTER_MODE_LOW_PASS) {
+      return lp;
+    } else if (mode == FILTER_MODE_BAND_PASS) {
+      return bp;
+    } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+      return bp * r_;
+    } else {
+      return hp;
+    }
+  }
+  
+  // The matrices are obtained by running the recursion on the basis vectors,
+  // which keeps them consistent with the serial implementation.
+  void Precompute() {
+    float s_1, s_2;
+    
+    // Response to the initial state.
+    s_1 = 1.0f;
+    s_2 = 0.0f;
+    for (size_t k = 0; k < block_size; ++k) {
+      m_1_[k] = Tick(0.0f, &s_1, &s_2);
+    }
+    a_11_ = s_1;
+    a_21_ = s_2;
+    
+    s_1 = 0.0f;
+    s_2 = 1.0f;
+    for (size_t k = 0; k < block_size; ++k) {
+      m_2_[k] = Tick(0.0f, &s_1, &s_2);
+    }
+    a_12_ = s_1;
+    a_22_ = s_2;
+    
+    // Impulse response, and contribution of each input sample to the state
+    // at the end of the block.
+    float impulse_response[block_size];
+    s_1 = s_2 = 0.0f;
+    for (size_t k = 0; k < block_size; ++k) {
+      impulse_response[k] = Tick(k == 0 ? 1.0f : 0.0f, &s_1, &s_2);
+      b_1_[block_size - 1 - k] = s_1;
+      b_2_[block_size - 1 - k] = s_2;
+    }
+    
+    for (size_t j = 0; j < block_size; ++j) {
+      for (size_t k = 0; k < block_size; ++k) {
+        t_[j][k] = k >= j ? impulse_response[k - j] : 0.0f;
+      }
+    }
+  }
+  
+  float g_;
+  float r_;
+  float h_;
+  
+  float state_1_;
+  float state_2_;
+  
+  // Column j of T: contribution of input sample j to each output.
+  Vector t_[block_size];
+  Vector m_1_;
+  Vector m_2_;
+  Vector b_1_;
+  Vector b_2_;
+  float a_11_, a_12_, a_21_, a_22_;
+  
+  DISALLOW_COPY_AND_ASSIGN(StateSpaceSvf);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_STATE_SPACE_SVF_H_
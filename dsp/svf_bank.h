@@ -0,0 +1,172 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Bank of N zero-delay-feedback SVFs, with coefficients and state stored in
+// structure-of-arrays layout so that several voices are processed by each
+// vector instruction.
+
+#ifndef STMLIB_DSP_SVF_BANK_H_
+#define STMLIB_DSP_SVF_BANK_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/simd.h"
+
+#include <algorithm>
+
+namespace stmlib {
+
+template<size_t N>
+class SvfBank {
+ private:
+  enum {
+    width = SimdWidth<N>::value
+  };
+  typedef typename FloatVector<width>::type Vector;
+
+ public:
+  SvfBank() { }
+  ~SvfBank() { }
+  
+  void Init() {
+    for (size_t i = 0; i < N; ++i) {
+      set_f_q<FREQUENCY_DIRTY>(i, 0.01f, 100.0f);
+    }
+    Reset();
+  }
+  
+  void Reset() {
+    std::fill(&state_1_[0], &state_1_[N], 0.0f);
+    std::fill(&state_2_[0], &state_2_[N], 0.0f);
+  }
+  
+  // Copy settings from a single filter.
+  inline void set(size_t voice, const Svf& f) {
+    g_[voice] = f.g();
+    r_[voice] = f.r();
+    h_[voice] = f.h();
+  }
+  
+  // Set all parameters from LUT.
+  inline void set_g_r_h(size_t voice, float g, float r, float h) {
+    g_[voice] = g;
+    r_[voice] = r;
+    h_[voice] = h;
+  }
+  
+  // Set frequency and resonance coefficients from LUT, adjust remaining
+  // parameter.
+  inline void set_g_r(size_t voice, float g, float r) {
+    g_[voice] = g;
+    r_[voice] = r;
+    h_[voice] = 1.0f / (1.0f + r * g + g * g);
+  }
+  
+  // Set frequency from LUT, resonance in true units, adjust the rest.
+  inline void set_g_q(size_t voice, float g, float resonance) {
+    set_g_r(voice, g, 1.0f / resonance);
+  }
+  
+  // Set frequency and resonance from true units.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(size_t voice, float f, float resonance) {
+    set_g_r(voice, OnePole::tan<approximation>(f), 1.0f / resonance);
+  }
+  
+  // Same thing, for all voices at once.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(const float* f, const float* resonance) {
+    for (size_t i = 0; i < N; ++i) {
+      set_f_q<approximation>(i, f[i], resonance[i]);
+    }
+  }
+  
+  // Process a single frame of N samples (one per voice).
+  template<FilterMode mode>
+  inline void Process(const float* in, float* out) {
+    Process<mode>(in, out, 1);
+  }
+  
+  // Process "size" frames of N samples. The input and output buffers are
+  // interleaved: in[i * N + voice]. Can be processed in place.
+  template<FilterMode mode>
+  inline void Process(const float* in, float* out, size_t size) {
+    for (size_t k = 0; k < N; k += width) {
+      const Vector g = SimdLoad<Vector>(&g_[k]);
+      const Vector r = SimdLoad<Vector>(&r_[k]);
+      const Vector h = SimdLoad<Vector>(&h_[k]);
+      const Vector r_plus_g = r + g;
+      Vector state_1 = SimdLoad<Vector>(&state_1_[k]);
+      Vector state_2 = SimdLoad<Vector>(&state_2_[k]);
+      
+      const float* x = in + k;
+      float* y = out + k;
+      for (size_t i = 0; i < size; ++i) {
+        Vector hp, bp, lp;
+        hp = (SimdLoad<Vector>(x) - r_plus_g * state_1 - state_2) * h;
+        bp = g * hp + state_1;
+        state_1 = g * hp + bp;
+        lp = g * bp + state_2;
+        state_2 = g * bp + lp;
+        
+        Vector value;
+        if (mode == FILTER_MODE_LOW_PASS) {
+          value = lp;
+        } else if (mode == FILTER_MODE_BAND_PASS) {
+          value = bp;
+        } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+          value = bp * r;
+        } else {
+          value = hp;
+        }
+        SimdStore(y, value);
+        x += N;
+        y += N;
+      }
+      SimdStore(&state_1_[k], state_1);
+      SimdStore(&state_2_[k], state_2);
+    }
+  }
+  
+  inline float g(size_t voice) const { return g_[voice]; }
+  inline float r(size_t voice) const { return r_[voice]; }
+  inline float h(size_t voice) const { return h_[voice]; }
+  
+ private:
+  float g_[N];
+  float r_[N];
+  float h_[N];
+  
+  float state_1_[N];
+  float state_2_[N];
+  
+  DISALLOW_COPY_AND_ASSIGN(SvfBank);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_SVF_BANK_H_
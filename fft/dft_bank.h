@@ -0,0 +1,355 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Banks of single-bin DFTs, for when only a few bins of the spectrum are
+// needed (tuners, tone detectors).
+//
+// GoertzelBank computes the bins over consecutive blocks of block_size
+// samples. SlidingDftBank updates them at every sample, over the last
+// window_size samples. The frequencies are set at run time, in cycles per
+// sample (frequency k / n for bin k of a n-point FFT), and need not fall on
+// the FFT bins. The magnitudes are in the same units as those computed from
+// ShyFFT's output by SpectrumMagnitude: |sum x[i] exp(2 pi j f i)|, with no
+// normalization by the number of samples.
+//
+// The bins are processed by SIMD vectors, in structure-of-arrays layout.
+
+#ifndef STMLIB_FFT_DFT_BANK_H_
+#define STMLIB_FFT_DFT_BANK_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "stmlib/dsp/rsqrt.h"
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+template<size_t num_bins>
+class GoertzelBank {
+ private:
+  enum {
+    width = SimdWidth<num_bins>::value
+  };
+  typedef typename FloatVector<width>::type Vector;
+  
+ public:
+  GoertzelBank() { }
+  ~GoertzelBank() { }
+  
+  // An empty block would make Process loop forever.
+  void Init(size_t block_size) {
+    assert(block_size > 0);
+    block_size_ = block_size;
+    for (size_t i = 0; i < num_bins; ++i) {
+      set_frequency(i, 0.0f);
+    }
+    std::fill(&power_[0], &power_[num_bins], 0.0f);
+    Reset();
+  }
+  
+  // Restarts the current block, with the latest frequencies.
+  void Reset() {
+    std::copy(&next_coefficient_[0], &next_coefficient_[num_bins],
+        &coefficient_[0]);
+    std::fill(&state_1_[0], &state_1_[num_bins], 0.0f);
+    std::fill(&state_2_[0], &state_2_[num_bins], 0.0f);
+    position_ = 0;
+  }
+  
+  // The new frequency is latched at the end of the current block, and used
+  // from the next one: changing it mid-block would mix two frequencies in the
+  // same sums.
+  inline void set_frequency(size_t bin, float f) {
+    next_coefficient_[bin] = 2.0f * cosf(2.0f * 3.141592653589793f * f);
+  }
+  
+  // Returns true if at least one block has been completed, in which case the
+  // magnitudes and powers are those of the last completed block.
+  inline bool Process(const float* in, size_t size) {
+    bool done = false;
+    while (size) {
+      size_t n = std::min(size, block_size_ - position_);
+      Accumulate(in, n);
+      in += n;
+      size -= n;
+      position_ += n;
+      if (position_ == block_size_) {
+        Finalize();
+        done = true;
+      }
+    }
+    return done;
+  }
+  
+  inline float power(size_t bin) const { return power_[bin]; }
+  
+  inline float magnitude(size_t bin) const {
+    float p = power_[bin];
+    return p == 0.0f ? 0.0f : p * fast_rsqrt_carmack(p);
+  }
+  
+ private:
+  inline void Accumulate(const float* in, size_t size) {
+    for (size_t k = 0; k < num_bins; k += width) {
+      const Vector coefficient = SimdLoad<Vector>(&coefficient_[k]);
+      Vector state_1 = SimdLoad<Vector>(&state_1_[k]);
+      Vector state_2 = SimdLoad<Vector>(&state_2_[k]);
+      for (size_t i = 0; i < size; ++i) {
+        Vector s = coefficient * state_1 - state_2 + in[i];
+        state_2 = state_1;
+        state_1 = s;
+      }
+      SimdStore(&state_1_[k], state_1);
+      SimdStore(&state_2_[k], state_2);
+    }
+  }
+  
+  inline void Finalize() {
+    for (size_t k = 0; k < num_bins; k += width) {
+      const Vector coefficient = SimdLoad<Vector>(&coefficient_[k]);
+      Vector state_1 = SimdLoad<Vector>(&state_1_[k]);
+      Vector state_2 = SimdLoad<Vector>(&state_2_[k]);
+      SimdStore(
+          &power_[k],
+          state_1 * state_1 + state_2 * state_2 -
+              coefficient * state_1 * state_2);
+    }
+    Reset();
+  }
+  
+  float coefficient_[num_bins];
+  float next_coefficient_[num_bins];
+  float state_1_[num_bins];
+  float state_2_[num_bins];
+  float power_[num_bins];
+  
+  size_t block_size_;
+  size_t position_;
+  
+  DISALLOW_COPY_AND_ASSIGN(GoertzelBank);
+};
+
+// The history of the last window_size samples is kept in a delay line. The
+// recursion has its poles on the unit circle, so the rounding errors slowly
+// accumulate. They are flushed every resync_period windows: for the duration
+// of one window, a second set of sums is accumulated from scratch alongside
+// the sliding ones, and replaces them at the end of the window. This doubles
+// the cost of that window - with no spike in any single call - and adds
+// 1 / resync_period to the average cost.
+template<size_t num_bins, size_t window_size>
+class SlidingDftBank {
+ private:
+  enum {
+    width = SimdWidth<num_bins>::value,
+    resync_period = 8
+  };
+  typedef typename FloatVector<width>::type Vector;
+  
+ public:
+  SlidingDftBank() { }
+  ~SlidingDftBank() { }
+  
+  void Init() {
+    for (size_t i = 0; i < num_bins; ++i) {
+      SetTwiddles(i, 0.0f);
+    }
+    Reset();
+  }
+  
+  void Reset() {
+    std::fill(&history_[0], &history_[window_size], 0.0f);
+    std::fill(&re_[0], &re_[num_bins], 0.0f);
+    std::fill(&im_[0], &im_[num_bins], 0.0f);
+    position_ = 0;
+    num_windows_ = 0;
+    resyncing_ = false;
+  }
+  
+  // Takes effect immediately. The sums accumulated at the previous frequency
+  // would never decay (the poles are on the unit circle), so those of the bin
+  // are recomputed from the history, which costs window_size complex
+  // multiply-adds: do not retune at every sample.
+  inline void set_frequency(size_t bin, float f) {
+    SetTwiddles(bin, f);
+    Resync(bin);
+  }
+  
+  inline void Process(const float* in, size_t size) {
+    while (size) {
+      size_t n = std::min(size, window_size - position_);
+      if (resyncing_) {
+        Update<true>(in, n);
+      } else {
+        Update<false>(in, n);
+      }
+      in += n;
+      size -= n;
+      position_ += n;
+      if (position_ == window_size) {
+        position_ = 0;
+        if (resyncing_) {
+          std::copy(&resync_re_[0], &resync_re_[num_bins], &re_[0]);
+          std::copy(&resync_im_[0], &resync_im_[num_bins], &im_[0]);
+          resyncing_ = false;
+        }
+        if (++num_windows_ == resync_period) {
+          num_windows_ = 0;
+          std::fill(&resync_re_[0], &resync_re_[num_bins], 0.0f);
+          std::fill(&resync_im_[0], &resync_im_[num_bins], 0.0f);
+          resyncing_ = true;
+        }
+      }
+    }
+  }
+  
+  inline float power(size_t bin) const {
+    return re_[bin] * re_[bin] + im_[bin] * im_[bin];
+  }
+  
+  inline float magnitude(size_t bin) const {
+    float p = power(bin);
+    return p == 0.0f ? 0.0f : p * fast_rsqrt_carmack(p);
+  }
+  
+  // Real and imaginary parts, with the phase referenced to the last sample.
+  inline float re(size_t bin) const { return re_[bin]; }
+  inline float im(size_t bin) const { return im_[bin]; }
+  
+ private:
+  inline void SetTwiddles(size_t bin, float f) {
+    // X[n] = x[n] + w X[n - 1] - w^N x[n - N], with w = exp(2 pi j f).
+    double omega = 2.0 * 3.141592653589793 * f;
+    double omega_n = omega * static_cast<double>(window_size);
+    w_re_[bin] = static_cast<float>(cos(omega));
+    w_im_[bin] = static_cast<float>(sin(omega));
+    w_n_re_[bin] = static_cast<float>(cos(omega_n));
+    w_n_im_[bin] = static_cast<float>(sin(omega_n));
+  }
+  
+  // Sum of the samples history_[start..end[, oldest first, weighted by the
+  // powers of w.
+  inline void Sum(
+      size_t bin,
+      size_t start,
+      size_t end,
+      float* re,
+      float* im) const {
+    const float w_re = w_re_[bin];
+    const float w_im = w_im_[bin];
+    float r = *re;
+    float i = *im;
+    for (size_t n = start; n < end; ++n) {
+      float new_r = w_re * r - w_im * i + history_[n];
+      i = w_re * i + w_im * r;
+      r = new_r;
+    }
+    *re = r;
+    *im = i;
+  }
+  
+  // The circular history starts with the oldest sample at position_. During
+  // a resync window, the resync sums only cover the samples received since
+  // the start of the window, that is to say history_[0..position_[.
+  inline void Resync(size_t bin) {
+    float re = 0.0f;
+    float im = 0.0f;
+    Sum(bin, position_, window_size, &re, &im);
+    Sum(bin, 0, position_, &re, &im);
+    re_[bin] = re;
+    im_[bin] = im;
+    if (resyncing_) {
+      re = im = 0.0f;
+      Sum(bin, 0, position_, &re, &im);
+      resync_re_[bin] = re;
+      resync_im_[bin] = im;
+    }
+  }
+  
+  // During a resync window, the sums of the samples received since the start
+  // of the window are accumulated too. At its end, they cover the whole
+  // window, with no history term to cancel.
+  template<bool resync>
+  inline void Update(const float* in, size_t size) {
+    float* history = &history_[position_];
+    for (size_t k = 0; k < num_bins; k += width) {
+      const Vector w_re = SimdLoad<Vector>(&w_re_[k]);
+      const Vector w_im = SimdLoad<Vector>(&w_im_[k]);
+      const Vector w_n_re = SimdLoad<Vector>(&w_n_re_[k]);
+      const Vector w_n_im = SimdLoad<Vector>(&w_n_im_[k]);
+      Vector re = SimdLoad<Vector>(&re_[k]);
+      Vector im = SimdLoad<Vector>(&im_[k]);
+      Vector resync_re = Vector();
+      Vector resync_im = Vector();
+      if (resync) {
+        resync_re = SimdLoad<Vector>(&resync_re_[k]);
+        resync_im = SimdLoad<Vector>(&resync_im_[k]);
+      }
+      for (size_t i = 0; i < size; ++i) {
+        float x = in[i];
+        float x_n = history[i];
+        Vector new_re = w_re * re - w_im * im - w_n_re * x_n + x;
+        im = w_re * im + w_im * re - w_n_im * x_n;
+        re = new_re;
+        if (resync) {
+          Vector new_resync_re = w_re * resync_re - w_im * resync_im + x;
+          resync_im = w_re * resync_im + w_im * resync_re;
+          resync_re = new_resync_re;
+        }
+      }
+      SimdStore(&re_[k], re);
+      SimdStore(&im_[k], im);
+      if (resync) {
+        SimdStore(&resync_re_[k], resync_re);
+        SimdStore(&resync_im_[k], resync_im);
+      }
+    }
+    std::copy(&in[0], &in[size], &history[0]);
+  }
+  
+  float w_re_[num_bins];
+  float w_im_[num_bins];
+  float w_n_re_[num_bins];
+  float w_n_im_[num_bins];
+  float re_[num_bins];
+  float im_[num_bins];
+  float resync_re_[num_bins];
+  float resync_im_[num_bins];
+  
+  float history_[window_size];
+  size_t position_;
+  size_t num_windows_;
+  bool resyncing_;
+  
+  DISALLOW_COPY_AND_ASSIGN(SlidingDftBank);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_DFT_BANK_H_
@@ -0,0 +1,130 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Twiddle factors table for ShyFFT, built by the compiler and stored in flash.
+// Same layout as LutPhasor, but with nothing to compute in Init() and no RAM
+// used:
+//
+//   ShyFFT<float, 1024, FlashLutPhasor> fft;
+//
+// Requires C++14.
+
+#ifndef STMLIB_FFT_FLASH_LUT_PHASOR_H_
+#define STMLIB_FFT_FLASH_LUT_PHASOR_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/constexpr_math.h"
+#include "stmlib/fft/shy_fft.h"
+
+namespace stmlib {
+
+// cos(k * pi / 2^pass), for k in [0, 2^(pass - 1)[, for each pass in
+// [3, num_passes[.
+template<typename T, size_t num_passes>
+struct FlashLutPhasorData {
+  constexpr FlashLutPhasorData() : values() {
+    for (size_t pass = 3; pass < num_passes; ++pass) {
+      size_t pass_size = static_cast<size_t>(1) << (pass - 1);
+      double increment = kConstexprPi / static_cast<double>(pass_size << 1);
+      for (size_t i = 0; i < pass_size; ++i) {
+        values[pass_size - 4 + i] = static_cast<T>(
+            ConstexprCos(increment * static_cast<double>(i)));
+      }
+    }
+  }
+  
+  T values[(1 << (num_passes - 1)) - 4];
+};
+
+template<typename T, size_t num_passes>
+class FlashLutPhasor {
+ public:
+  FlashLutPhasor() { }
+  ~FlashLutPhasor() { }
+  
+  void Init() { }
+  
+  inline void Start(size_t pass) {
+    size_t pass_size = 1 << (pass - 1);
+    cos_ptr_ = &lut_.values[pass_size - 4 + 1];
+    sin_ptr_ = &lut_.values[pass_size + pass_size - 4 - 1];
+  }
+  
+  inline void Rotate() {
+    ++cos_ptr_;
+    --sin_ptr_;
+  }
+  
+  inline T cos() const { return *cos_ptr_; }
+  inline T sin() const { return *sin_ptr_; }
+  
+  inline const T* table(size_t pass) const {
+    return &lut_.values[(1 << (pass - 1)) - 4];
+  }
+  
+ private:
+  static constexpr FlashLutPhasorData<T, num_passes> lut_ =
+      FlashLutPhasorData<T, num_passes>();
+  
+  const T* cos_ptr_;
+  const T* sin_ptr_;
+  
+  DISALLOW_COPY_AND_ASSIGN(FlashLutPhasor);
+};
+
+template<typename T, size_t num_passes>
+constexpr FlashLutPhasorData<T, num_passes> FlashLutPhasor<T, num_passes>::lut_;
+
+template<typename T> struct FlashLutPhasor<T, 0> { void Init() { }; };
+template<typename T> struct FlashLutPhasor<T, 1> { void Init() { }; };
+template<typename T> struct FlashLutPhasor<T, 2> { void Init() { }; };
+
+template<typename T>
+struct FlashLutPhasor<T, 3> {
+  void Init() { };
+  void Start(size_t) { };
+  void Rotate() { };
+  inline T cos() const { return 1.0; }
+  inline T sin() const { return 0.0; }
+  inline const T* table(size_t) const { return NULL; }
+};
+
+#if STMLIB_SIMD_MAX_WIDTH >= 4
+
+template<size_t num_passes>
+struct DirectButterflies<float, FlashLutPhasor<float, num_passes> >
+    : public TableDirectButterflies<FlashLutPhasor<float, num_passes> > { };
+
+template<size_t num_passes>
+struct InverseButterflies<float, FlashLutPhasor<float, num_passes> >
+    : public TableInverseButterflies<FlashLutPhasor<float, num_passes> > { };
+
+#endif  // STMLIB_SIMD_MAX_WIDTH >= 4
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_FLASH_LUT_PHASOR_H_
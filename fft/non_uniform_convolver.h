@@ -0,0 +1,607 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Non-uniformly partitioned convolution, for long impulse responses with no
+// latency.
+//
+// The first block_size taps are computed in direct form. The rest of the
+// impulse response is split into stages of uniformly partitioned convolution
+// (overlap-save), whose partition size doubles from one stage to the next,
+// up to max_partition_size:
+//
+// Stage 0: partitions of block_size, taps [B, 4B[.
+// Stage k: partitions of P = 2^k B, taps [2P, 4P[.
+// Last stage: partitions of max_partition_size, the remaining taps.
+//
+// The output of stage k is needed P samples after the end of the input frame,
+// so its work is spread over the P / block_size following blocks, instead of
+// being computed at once every P / block_size blocks: the CPU load is the same
+// for all blocks. For this, the transforms of 2P points are decomposed into
+// 2^k transforms of 2 * block_size points (done with ShyFFT), followed by k
+// passes of radix-2 butterflies on the packed spectra, which can be sliced.
+
+#ifndef STMLIB_FFT_NON_UNIFORM_CONVOLVER_H_
+#define STMLIB_FFT_NON_UNIFORM_CONVOLVER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "stmlib/dsp/simd.h"
+#include "stmlib/fft/shy_fft.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+namespace stmlib {
+
+template<size_t block_size, size_t max_partition_size>
+class NonUniformConvolver {
+ public:
+  enum {
+    fft_size = 2 * block_size,
+    num_stages = Log2<max_partition_size / block_size>::value + 1
+  };
+  
+  NonUniformConvolver() { }
+  ~NonUniformConvolver() { }
+  
+  // Allocates the buffers for impulse responses of up to max_ir_size
+  // samples. If the allocator runs out of memory, the convolver is silent.
+  void Init(BufferAllocator* allocator, size_t max_ir_size) {
+    fft_.Init();
+    
+    // Layout of the partitions.
+    num_used_stages_ = 0;
+    size_t largest_partition = block_size;
+    for (size_t s = 0; s < num_stages; ++s) {
+      Stage* stage = &stage_[s];
+      stage->log_ratio = s;
+      stage->partition_size = block_size << s;
+      stage->start = s == 0 ? block_size : 2 * stage->partition_size;
+      if (stage->start >= max_ir_size) {
+        break;
+      }
+      size_t remaining = max_ir_size - stage->start;
+      stage->max_num_partitions = \
+          (remaining + stage->partition_size - 1) / stage->partition_size;
+      if (s != num_stages - 1) {
+        stage->max_num_partitions = std::min(
+            stage->max_num_partitions,
+            static_cast<size_t>(s == 0 ? 3 : 2));
+      }
+      largest_partition = stage->partition_size;
+      ++num_used_stages_;
+    }
+    
+    // Allocation.
+    ring_size_ = 4 * largest_partition;
+    twiddle_ratio_ = largest_partition;
+    bool ok = true;
+    head_ = Allocate(allocator, block_size, &ok);
+    history_ = Allocate(allocator, 2 * block_size, &ok);
+    input_ = Allocate(allocator, ring_size_, &ok);
+    output_ = Allocate(allocator, ring_size_, &ok);
+    scratch_ = Allocate(allocator, 2 * fft_size, &ok);
+    cos_ = Allocate(allocator, largest_partition / 2 + 1, &ok);
+    for (size_t s = 0; s < num_used_stages_; ++s) {
+      Stage* stage = &stage_[s];
+      size_t size = 2 * stage->partition_size;
+      size_t n = stage->max_num_partitions;
+      stage->ir_spectra = Allocate(allocator, n * size, &ok);
+      stage->input_spectra = Allocate(allocator, n * size, &ok);
+      stage->work[0] = Allocate(allocator, size, &ok);
+      stage->work[1] = Allocate(allocator, size, &ok);
+      stage->accumulator = Allocate(allocator, size, &ok);
+      stage->num_partitions = 0;
+    }
+    if (!ok) {
+      num_used_stages_ = 0;
+      head_ = NULL;
+      return;
+    }
+    
+    // cos(pi i / P), i in [0, P / 2]. The butterflies of the transforms of
+    // 2M points use every (P / M)-th value.
+    float increment = 3.141592653589793f / static_cast<float>(twiddle_ratio_);
+    for (size_t i = 0; i <= twiddle_ratio_ / 2; ++i) {
+      cos_[i] = cosf(increment * static_cast<float>(i));
+    }
+    
+    std::fill(&head_[0], &head_[block_size], 0.0f);
+    Reset();
+  }
+  
+  // Clears the input history.
+  void Reset() {
+    if (!head_) {
+      return;
+    }
+    time_ = 0;
+    std::fill(&history_[0], &history_[2 * block_size], 0.0f);
+    std::fill(&input_[0], &input_[ring_size_], 0.0f);
+    std::fill(&output_[0], &output_[ring_size_], 0.0f);
+    for (size_t s = 0; s < num_used_stages_; ++s) {
+      Stage* stage = &stage_[s];
+      size_t size = 2 * stage->partition_size;
+      std::fill(
+          &stage->input_spectra[0],
+          &stage->input_spectra[stage->max_num_partitions * size],
+          0.0f);
+      stage->slot = 0;
+      stage->unit = stage->num_units = 0;
+      stage->cost = stage->total_cost = 0;
+      stage->block = 0;
+    }
+  }
+  
+  // Computes the spectra of the partitions of the impulse response, and
+  // clears the input history. This runs all the transforms at once: call it
+  // outside of the audio processing. The impulse response is truncated to
+  // the allocated partitions: block_size samples at least, otherwise
+  // max_ir_size rounded up to a whole number of partitions of the last stage.
+  void set_impulse_response(const float* ir, size_t size) {
+    if (!head_) {
+      return;
+    }
+    for (size_t i = 0; i < block_size; ++i) {
+      head_[block_size - 1 - i] = i < size ? ir[i] : 0.0f;
+    }
+    
+    for (size_t s = 0; s < num_used_stages_; ++s) {
+      Stage* stage = &stage_[s];
+      size_t p_size = stage->partition_size;
+      size_t num_partitions = 0;
+      if (stage->start < size) {
+        num_partitions = (size - stage->start + p_size - 1) / p_size;
+        num_partitions = std::min(num_partitions, stage->max_num_partitions);
+      }
+      stage->num_partitions = num_partitions;
+      
+      // The 1 / (2 P) scale of the inverse transform is applied here.
+      const float scale = 1.0f / static_cast<float>(2 * p_size);
+      for (size_t p = 0; p < num_partitions; ++p) {
+        float* frame = stage->accumulator;
+        for (size_t i = 0; i < p_size; ++i) {
+          size_t t = stage->start + p * p_size + i;
+          frame[i] = t < size ? ir[t] * scale : 0.0f;
+        }
+        std::fill(&frame[p_size], &frame[2 * p_size], 0.0f);
+        
+        float* spectrum = &stage->ir_spectra[p * 2 * p_size];
+        size_t num_blocks = 1 << stage->log_ratio;
+        for (size_t b = 0; b < num_blocks; ++b) {
+          SubTransform(stage, frame, 0, 2 * p_size - 1, b, spectrum);
+        }
+        for (size_t l = 1; l <= stage->log_ratio; ++l) {
+          for (size_t q = 0; q < num_blocks; ++q) {
+            DirectPass(stage, l, q, spectrum);
+          }
+        }
+      }
+    }
+    Reset();
+  }
+  
+  // size must be a multiple of block_size. in and out can be the same buffer.
+  void Process(const float* in, float* out, size_t size) {
+    assert(size % block_size == 0);
+    while (size) {
+      ProcessBlock(in, out);
+      in += block_size;
+      out += block_size;
+      size -= block_size;
+    }
+  }
+  
+ private:
+  struct Stage {
+    size_t log_ratio;  // log2(partition_size / block_size)
+    size_t partition_size;
+    size_t start;
+    size_t max_num_partitions;
+    size_t num_partitions;
+    
+    float* ir_spectra;
+    float* input_spectra;
+    float* work[2];
+    float* accumulator;
+    
+    size_t slot;  // Slot of the latest input spectrum.
+    size_t frame_end;
+    
+    // Progress of the computations for the latest input frame.
+    size_t unit;
+    size_t num_units;
+    size_t cost;
+    size_t total_cost;
+    size_t block;
+  };
+  
+  // The work for one input frame is split in units, which process about
+  // fft_size values each:
+  enum UnitType {
+    UNIT_TRANSFORM,  // Transforms of fft_size points.
+    UNIT_DIRECT_PASS,  // Slice of a pass of butterflies of the direct FFT.
+    UNIT_MULTIPLY_ACCUMULATE,  // Slice of a product with a partition.
+    UNIT_INVERSE_PASS,  // Slice of a pass of butterflies of the inverse FFT.
+    UNIT_INVERSE_TRANSFORM
+  };
+  
+  // Relative costs of the units (measured on a x86-64 host), used to give
+  // the same amount of work to all blocks.
+  static inline size_t cost(UnitType type) {
+    switch (type) {
+      case UNIT_TRANSFORM:
+      case UNIT_INVERSE_TRANSFORM:
+        return 12;
+      case UNIT_MULTIPLY_ACCUMULATE:
+        return 2;
+      default:
+        return 3;
+    }
+  }
+  
+  static float* Allocate(BufferAllocator* allocator, size_t size, bool* ok) {
+    float* p = allocator->Allocate<float>(size);
+    *ok = *ok && p;
+    return p;
+  }
+  
+  void ProcessBlock(const float* in, float* out) {
+    if (!head_) {
+      std::fill(&out[0], &out[block_size], 0.0f);
+      return;
+    }
+    
+    const size_t mask = ring_size_ - 1;
+    size_t now = time_ & mask;
+    std::copy(&in[0], &in[block_size], &input_[now]);
+    std::copy(&history_[block_size], &history_[2 * block_size], &history_[0]);
+    std::copy(&in[0], &in[block_size], &history_[block_size]);
+    time_ += block_size;
+    
+    // Stage k processes the frame which has just been completed, while the
+    // output ring buffer is read (and cleared) up to the current sample.
+    for (size_t s = 0; s < num_used_stages_; ++s) {
+      Stage* stage = &stage_[s];
+      if (!stage->num_partitions) {
+        continue;
+      }
+      if ((time_ & (stage->partition_size - 1)) == 0) {
+        StartFrame(stage);
+      }
+      size_t num_blocks = 1 << stage->log_ratio;
+      ++stage->block;
+      size_t target = stage->total_cost * stage->block / num_blocks;
+      while (stage->unit < stage->num_units && stage->cost < target) {
+        RunUnit(stage, stage->unit++);
+      }
+    }
+    
+    // Head in direct form, and output of the stages.
+    typedef typename FloatVector<SimdWidth<block_size>::value>::type Vector;
+    const size_t width = SimdWidth<block_size>::value;
+    for (size_t i = 0; i < block_size; ++i) {
+      const float* x = &history_[i + 1];
+      Vector sum = SimdSplat<Vector>(0.0f);
+      for (size_t j = 0; j < block_size; j += width) {
+        sum += SimdLoad<Vector>(&head_[j]) * SimdLoad<Vector>(&x[j]);
+      }
+      float y = 0.0f;
+      const float* lanes = reinterpret_cast<const float*>(&sum);
+      for (size_t j = 0; j < width; ++j) {
+        y += lanes[j];
+      }
+      y += output_[now + i];
+      output_[now + i] = 0.0f;
+      out[i] = y;
+    }
+  }
+  
+  void StartFrame(Stage* stage) {
+    // Should not happen, unless the costs are badly estimated.
+    while (stage->unit < stage->num_units) {
+      RunUnit(stage, stage->unit++);
+    }
+    stage->frame_end = time_;
+    stage->slot = stage->slot == 0
+        ? stage->max_num_partitions - 1
+        : stage->slot - 1;
+    
+    size_t num_blocks = 1 << stage->log_ratio;
+    size_t num_passes = stage->log_ratio;
+    stage->unit = 0;
+    stage->num_units = num_blocks * \
+        (2 + 2 * num_passes + stage->num_partitions);
+    stage->cost = 0;
+    stage->total_cost = num_blocks * (
+        cost(UNIT_TRANSFORM) + num_passes * cost(UNIT_DIRECT_PASS) + \
+        stage->num_partitions * cost(UNIT_MULTIPLY_ACCUMULATE) + \
+        num_passes * cost(UNIT_INVERSE_PASS) + \
+        cost(UNIT_INVERSE_TRANSFORM));
+    stage->block = 0;
+  }
+  
+  void RunUnit(Stage* stage, size_t unit) {
+    size_t num_blocks = 1 << stage->log_ratio;
+    size_t num_passes = stage->log_ratio;
+    size_t size = 2 * stage->partition_size;
+    float* spectrum = &stage->input_spectra[stage->slot * size];
+    
+    size_t index = unit & (num_blocks - 1);
+    size_t step = unit >> stage->log_ratio;
+    UnitType type;
+    if (step < 1) {
+      type = UNIT_TRANSFORM;
+      SubTransform(
+          stage,
+          input_,
+          stage->frame_end - size,
+          ring_size_ - 1,
+          index,
+          spectrum);
+    } else if ((step -= 1) < num_passes) {
+      type = UNIT_DIRECT_PASS;
+      DirectPass(stage, step + 1, index, spectrum);
+    } else if ((step -= num_passes) < stage->num_partitions) {
+      type = UNIT_MULTIPLY_ACCUMULATE;
+      size_t slot = stage->slot + step;
+      if (slot >= stage->max_num_partitions) {
+        slot -= stage->max_num_partitions;
+      }
+      MultiplyAccumulate(
+          &stage->input_spectra[slot * size],
+          &stage->ir_spectra[step * size],
+          stage->accumulator,
+          size,
+          index,
+          step != 0);
+    } else if ((step -= stage->num_partitions) < num_passes) {
+      type = UNIT_INVERSE_PASS;
+      InversePass(stage, num_passes - step, index);
+    } else {
+      type = UNIT_INVERSE_TRANSFORM;
+      InverseSubTransform(stage, index);
+    }
+    stage->cost += cost(type);
+  }
+  
+  // Bit reversal of the index of a sub-transform: sub-transform b processes
+  // the samples r + 2^k m, with r the bit reversal of b on k bits.
+  static inline size_t Residue(size_t b, size_t num_bits) {
+    size_t r = 0;
+    for (size_t i = 0; i < num_bits; ++i) {
+      r = (r << 1) | (b & 1);
+      b >>= 1;
+    }
+    return r;
+  }
+  
+  // Work buffer in which the pass l of the direct transform writes. The last
+  // pass writes in the destination spectrum.
+  inline float* direct_buffer(Stage* stage, size_t l, float* destination) {
+    return l == stage->log_ratio
+        ? destination
+        : stage->work[(stage->log_ratio - l) & 1];
+  }
+  
+  // Work buffer in which the pass l of the inverse transform writes. The
+  // first pass reads the accumulator.
+  inline float* inverse_buffer(Stage* stage, size_t l) {
+    return l == stage->log_ratio + 1
+        ? stage->accumulator
+        : stage->work[(stage->log_ratio - l) & 1];
+  }
+  
+  // Transforms of fft_size points of the decimated frame. The frame is read
+  // from source[(offset + i) & mask].
+  void SubTransform(
+      Stage* stage,
+      const float* source,
+      size_t offset,
+      size_t mask,
+      size_t b,
+      float* destination) {
+    size_t stride = 1 << stage->log_ratio;
+    size_t r = Residue(b, stage->log_ratio);
+    float* in = scratch_;
+    for (size_t m = 0; m < fft_size; ++m) {
+      in[m] = source[(offset + r + m * stride) & mask];
+    }
+    float* out = direct_buffer(stage, 0, destination);
+    fft_.Direct(in, &out[b * fft_size]);
+  }
+  
+  void InverseSubTransform(Stage* stage, size_t b) {
+    size_t size = 2 * stage->partition_size;
+    size_t stride = 1 << stage->log_ratio;
+    size_t r = Residue(b, stage->log_ratio);
+    float* in = &inverse_buffer(stage, 1)[b * fft_size];
+    float* out = scratch_ + fft_size;
+    fft_.Inverse(in, out);
+    
+    // Only the second half of the frame is valid. It is added to the output
+    // start - P samples after the end of the frame.
+    const size_t mask = ring_size_ - 1;
+    size_t t = stage->frame_end - size + stage->start;
+    for (size_t m = block_size; m < fft_size; ++m) {
+      output_[(t + r + m * stride) & mask] += out[m];
+    }
+  }
+  
+  // Slice q of the pass l of butterflies, which merges the spectra of two
+  // decimated sequences of M points into the spectrum of 2M points. Each slice
+  // computes block_size / 2 butterflies.
+  void DirectPass(Stage* stage, size_t l, size_t q, float* destination) {
+    const float* source = direct_buffer(stage, l - 1, destination);
+    float* d = direct_buffer(stage, l, destination);
+    
+    size_t m = block_size << l;
+    size_t m_2 = m >> 1;
+    size_t twiddle_stride = twiddle_ratio_ / m;
+    size_t block = q >> l;
+    size_t j_start = (q & ((1 << l) - 1)) * (block_size / 2);
+    size_t j_end = j_start + block_size / 2;
+    
+    const float* s1r = source + block * 2 * m;
+    const float* s2r = s1r + m;
+    const float* s1i = s1r + m_2;
+    const float* s2i = s2r + m_2;
+    float* dr = d + block * 2 * m;
+    float* di = dr + m;
+    
+    if (j_start == 0) {
+      dr[0] = s1r[0] + s2r[0];
+      di[0] = s1r[0] - s2r[0];
+      dr[m_2] = s1r[m_2];
+      di[m_2] = s2r[m_2];
+      j_start = 1;
+    }
+    for (size_t j = j_start; j < j_end; ++j) {
+      float c = cos_[j * twiddle_stride];
+      float s = cos_[(m_2 - j) * twiddle_stride];
+      float v;
+      
+      v = s2r[j] * c - s2i[j] * s;
+      dr[j] = s1r[j] + v;
+      di[-j] = s1r[j] - v;
+      
+      v = s2r[j] * s + s2i[j] * c;
+      di[j] = v + s1i[j];
+      di[m - j] = v - s1i[j];
+    }
+  }
+  
+  // Slice q of the pass l of the inverse transform, which splits a spectrum
+  // of 2M points into the spectra of the two decimated sequences of M points.
+  void InversePass(Stage* stage, size_t l, size_t q) {
+    const float* source = inverse_buffer(stage, l + 1);
+    float* d = inverse_buffer(stage, l);
+    
+    size_t m = block_size << l;
+    size_t m_2 = m >> 1;
+    size_t twiddle_stride = twiddle_ratio_ / m;
+    size_t block = q >> l;
+    size_t j_start = (q & ((1 << l) - 1)) * (block_size / 2);
+    size_t j_end = j_start + block_size / 2;
+    
+    const float* sr = source + block * 2 * m;
+    const float* si = sr + m;
+    float* d1r = d + block * 2 * m;
+    float* d2r = d1r + m;
+    float* d1i = d1r + m_2;
+    float* d2i = d2r + m_2;
+    
+    if (j_start == 0) {
+      d1r[0] = sr[0] + si[0];
+      d2r[0] = sr[0] - si[0];
+      d1r[m_2] = sr[m_2] * 2.0f;
+      d2r[m_2] = si[m_2] * 2.0f;
+      j_start = 1;
+    }
+    for (size_t j = j_start; j < j_end; ++j) {
+      float c = cos_[j * twiddle_stride];
+      float s = cos_[(m_2 - j) * twiddle_stride];
+      
+      d1r[j] = sr[j] + si[-j];
+      d1i[j] = si[j] - si[m - j];
+      
+      float vr = sr[j] - si[-j];
+      float vi = si[j] + si[m - j];
+      
+      d2r[j] = vr * c + vi * s;
+      d2i[j] = vi * c - vr * s;
+    }
+  }
+  
+  // Slice q (bins [q B, (q + 1) B[) of y (+)= x * h, on packed spectra of
+  // the given size.
+  static void MultiplyAccumulate(
+      const float* x,
+      const float* h,
+      float* y,
+      size_t size,
+      size_t q,
+      bool accumulate) {
+    typedef typename FloatVector<SimdWidth<block_size>::value>::type Vector;
+    const size_t width = SimdWidth<block_size>::value;
+    const size_t half = size / 2;
+    size_t start = q * block_size;
+    
+    float dc = x[0] * h[0];
+    float nyquist = x[half] * h[half];
+    if (accumulate) {
+      dc += y[0];
+      nyquist += y[half];
+    }
+    
+    const float* x_i = x + half;
+    const float* h_i = h + half;
+    float* y_i = y + half;
+    for (size_t k = start; k < start + block_size; k += width) {
+      Vector xr = SimdLoad<Vector>(x + k);
+      Vector xi = SimdLoad<Vector>(x_i + k);
+      Vector hr = SimdLoad<Vector>(h + k);
+      Vector hi = SimdLoad<Vector>(h_i + k);
+      Vector yr = xr * hr - xi * hi;
+      Vector yi = xr * hi + xi * hr;
+      if (accumulate) {
+        yr += SimdLoad<Vector>(y + k);
+        yi += SimdLoad<Vector>(y_i + k);
+      }
+      SimdStore(y + k, yr);
+      SimdStore(y_i + k, yi);
+    }
+    
+    // Slot 0 of the imaginary parts holds the Nyquist bin.
+    if (start == 0) {
+      y[0] = dc;
+      y[half] = nyquist;
+    }
+  }
+  
+  ShyFFT<float, fft_size, LutPhasor> fft_;
+  Stage stage_[num_stages];
+  size_t num_used_stages_;
+  
+  float* head_;
+  float* history_;
+  float* input_;
+  float* output_;
+  float* scratch_;
+  float* cos_;
+  
+  size_t ring_size_;
+  size_t twiddle_ratio_;
+  size_t time_;
+  
+  DISALLOW_COPY_AND_ASSIGN(NonUniformConvolver);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_NON_UNIFORM_CONVOLVER_H_
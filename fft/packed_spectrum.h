@@ -0,0 +1,225 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Arithmetic on the packed real spectra produced by ShyFFT.
+//
+// A spectrum of n points holds the real parts of bins 0 to n / 2 in [0, n / 2],
+// and the imaginary parts of bins 1 to n / 2 - 1 in ]n / 2, n[. The DC and
+// Nyquist bins are real. Per-bin quantities (magnitude, power, phase, gain) are
+// arrays of n / 2 + 1 values.
+//
+// ShyFFT computes the conjugate of the usual DFT: the imaginary parts are
+// negated. This does not matter for products, magnitudes and powers, but the
+// phases are those of the conjugate too.
+//
+// The output may be the same buffer as any of the inputs.
+
+#ifndef STMLIB_FFT_PACKED_SPECTRUM_H_
+#define STMLIB_FFT_PACKED_SPECTRUM_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/atan.h"
+#include "stmlib/dsp/rsqrt.h"
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+// y = x * h.
+template<size_t n>
+inline void SpectrumMultiply(const float* x, const float* h, float* y) {
+  typedef typename FloatVector<SimdWidth<n / 2>::value>::type Vector;
+  const size_t width = SimdWidth<n / 2>::value;
+  const size_t half = n / 2;
+  
+  float dc = x[0] * h[0];
+  float nyquist = x[half] * h[half];
+  for (size_t k = 0; k < half; k += width) {
+    Vector xr = SimdLoad<Vector>(x + k);
+    Vector xi = SimdLoad<Vector>(x + half + k);
+    Vector hr = SimdLoad<Vector>(h + k);
+    Vector hi = SimdLoad<Vector>(h + half + k);
+    SimdStore(y + k, xr * hr - xi * hi);
+    SimdStore(y + half + k, xr * hi + xi * hr);
+  }
+  
+  // Slot 0 of the imaginary parts holds the Nyquist bin, so the complex
+  // product is wrong for these two values.
+  y[0] = dc;
+  y[half] = nyquist;
+}
+
+// y += x * h.
+template<size_t n>
+inline void SpectrumMultiplyAccumulate(
+    const float* x,
+    const float* h,
+    float* y) {
+  typedef typename FloatVector<SimdWidth<n / 2>::value>::type Vector;
+  const size_t width = SimdWidth<n / 2>::value;
+  const size_t half = n / 2;
+  
+  float dc = y[0] + x[0] * h[0];
+  float nyquist = y[half] + x[half] * h[half];
+  for (size_t k = 0; k < half; k += width) {
+    Vector xr = SimdLoad<Vector>(x + k);
+    Vector xi = SimdLoad<Vector>(x + half + k);
+    Vector hr = SimdLoad<Vector>(h + k);
+    Vector hi = SimdLoad<Vector>(h + half + k);
+    SimdStore(y + k, SimdLoad<Vector>(y + k) + xr * hr - xi * hi);
+    SimdStore(y + half + k, SimdLoad<Vector>(y + half + k) + xr * hi + xi * hr);
+  }
+  y[0] = dc;
+  y[half] = nyquist;
+}
+
+// y = x * conj(h). The inverse transform of the product is the circular
+// cross-correlation of the two signals.
+template<size_t n>
+inline void SpectrumConjugateMultiply(
+    const float* x,
+    const float* h,
+    float* y) {
+  typedef typename FloatVector<SimdWidth<n / 2>::value>::type Vector;
+  const size_t width = SimdWidth<n / 2>::value;
+  const size_t half = n / 2;
+  
+  float dc = x[0] * h[0];
+  float nyquist = x[half] * h[half];
+  for (size_t k = 0; k < half; k += width) {
+    Vector xr = SimdLoad<Vector>(x + k);
+    Vector xi = SimdLoad<Vector>(x + half + k);
+    Vector hr = SimdLoad<Vector>(h + k);
+    Vector hi = SimdLoad<Vector>(h + half + k);
+    SimdStore(y + k, xr * hr + xi * hi);
+    SimdStore(y + half + k, xi * hr - xr * hi);
+  }
+  y[0] = dc;
+  y[half] = nyquist;
+}
+
+// Multiplies each bin by a real gain.
+template<size_t n>
+inline void SpectrumGain(const float* x, const float* gain, float* y) {
+  typedef typename FloatVector<SimdWidth<n / 2>::value>::type Vector;
+  const size_t width = SimdWidth<n / 2>::value;
+  const size_t half = n / 2;
+  
+  float nyquist = x[half] * gain[half];
+  for (size_t k = 0; k < half; k += width) {
+    Vector g = SimdLoad<Vector>(gain + k);
+    SimdStore(y + k, SimdLoad<Vector>(x + k) * g);
+    SimdStore(y + half + k, SimdLoad<Vector>(x + half + k) * g);
+  }
+  y[half] = nyquist;
+}
+
+template<size_t n>
+inline void SpectrumPower(const float* x, float* power) {
+  typedef typename FloatVector<SimdWidth<n / 2>::value>::type Vector;
+  const size_t width = SimdWidth<n / 2>::value;
+  const size_t half = n / 2;
+  
+  float dc = x[0] * x[0];
+  float nyquist = x[half] * x[half];
+  for (size_t k = 0; k < half; k += width) {
+    Vector re = SimdLoad<Vector>(x + k);
+    Vector im = SimdLoad<Vector>(x + half + k);
+    SimdStore(power + k, re * re + im * im);
+  }
+  power[0] = dc;
+  power[half] = nyquist;
+}
+
+template<size_t n>
+inline void SpectrumMagnitude(const float* x, float* magnitude) {
+  const size_t half = n / 2;
+  
+  SpectrumPower<n>(x, magnitude);
+  for (size_t k = 0; k <= half; ++k) {
+    float p = magnitude[k];
+    magnitude[k] = p == 0.0f ? 0.0f : p * fast_rsqrt_carmack(p);
+  }
+}
+
+// The phase is in the same unit as fast_atan2r: 65536 for a full turn. Since
+// ShyFFT stores the conjugate spectrum, this is the negated phase of the usual
+// DFT: a cosine starting at phase phi yields -phi in its bin. Add rather than
+// subtract to delay a bin, and do not mix these phases with ones computed
+// from another transform.
+template<size_t n>
+inline void SpectrumToPolar(
+    const float* x,
+    float* magnitude,
+    uint16_t* phase) {
+  const size_t half = n / 2;
+  
+  phase[0] = fast_atan2r(0.0f, x[0], &magnitude[0]);
+  phase[half] = fast_atan2r(0.0f, x[half], &magnitude[half]);
+  for (size_t k = 1; k < half; ++k) {
+    phase[k] = fast_atan2r(x[half + k], x[k], &magnitude[k]);
+  }
+}
+
+// sin(2 pi phase / 65536), to within 4e-6.
+inline float SpectrumSine(uint16_t phase) {
+  // Folds the angle to [-pi / 2, pi / 2], where the sine is approximated by
+  // its Taylor expansion, to the 9th order.
+  float t = static_cast<float>(static_cast<int16_t>(phase)) * (1.0f / 16384.0f);
+  if (t > 1.0f) {
+    t = 2.0f - t;
+  } else if (t < -1.0f) {
+    t = -2.0f - t;
+  }
+  float t2 = t * t;
+  return t * (1.5707963f - t2 * (0.64596409f - t2 * (0.079692626f -
+      t2 * (0.0046817541f - t2 * 0.00016044118f))));
+}
+
+// The inverse of SpectrumToPolar, with the same (negated) phase convention, so
+// that the spectrum can go back to ShyFFT::Inverse. The DC and Nyquist bins
+// take the sign of the cosine of their phase.
+template<size_t n>
+inline void SpectrumFromPolar(
+    const float* magnitude,
+    const uint16_t* phase,
+    float* x) {
+  const size_t half = n / 2;
+  
+  float dc = SpectrumSine(phase[0] + 16384) * magnitude[0];
+  float nyquist = SpectrumSine(phase[half] + 16384) * magnitude[half];
+  for (size_t k = 1; k < half; ++k) {
+    float m = magnitude[k];
+    x[k] = SpectrumSine(phase[k] + 16384) * m;
+    x[half + k] = SpectrumSine(phase[k]) * m;
+  }
+  x[0] = dc;
+  x[half] = nyquist;
+}
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_PACKED_SPECTRUM_H_
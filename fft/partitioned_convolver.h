@@ -0,0 +1,180 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Uniformly partitioned convolution (overlap-save), for long impulse
+// responses at a fixed latency.
+//
+// The impulse response is split into partitions of block_size samples, whose
+// spectra (2 * block_size points) are precomputed. The spectra of the last
+// input frames are kept in a frequency-domain delay line. For each block, the
+// output spectrum is the sum of the products of the input spectra with the
+// partition spectra, and the second half of its inverse transform is the
+// output block.
+//
+// All the buffers are obtained from a BufferAllocator at initialization.
+
+#ifndef STMLIB_FFT_PARTITIONED_CONVOLVER_H_
+#define STMLIB_FFT_PARTITIONED_CONVOLVER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "stmlib/fft/packed_spectrum.h"
+#include "stmlib/fft/shy_fft.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+namespace stmlib {
+
+template<size_t block_size>
+class PartitionedConvolver {
+ public:
+  enum {
+    fft_size = 2 * block_size
+  };
+  
+  PartitionedConvolver() { }
+  ~PartitionedConvolver() { }
+  
+  // Allocates the buffers for impulse responses of up to max_ir_size
+  // samples. If the allocator runs out of memory, the convolver is silent.
+  void Init(BufferAllocator* allocator, size_t max_ir_size) {
+    fft_.Init();
+    
+    size_t max_num_partitions = (max_ir_size + block_size - 1) / block_size;
+    ir_spectra_ = allocator->Allocate<float>(max_num_partitions * fft_size);
+    input_spectra_ = allocator->Allocate<float>(max_num_partitions * fft_size);
+    input_ = allocator->Allocate<float>(fft_size);
+    fft_in_ = allocator->Allocate<float>(fft_size);
+    fft_out_ = allocator->Allocate<float>(fft_size);
+    if (!ir_spectra_ || !input_spectra_ || !input_ || !fft_in_ || !fft_out_) {
+      max_num_partitions = 0;
+    }
+    max_num_partitions_ = max_num_partitions;
+    num_partitions_ = 0;
+    head_ = 0;
+    Reset();
+  }
+  
+  // Clears the input history.
+  void Reset() {
+    if (!max_num_partitions_) {
+      return;
+    }
+    std::fill(&input_[0], &input_[fft_size], 0.0f);
+    std::fill(
+        &input_spectra_[0],
+        &input_spectra_[max_num_partitions_ * fft_size],
+        0.0f);
+  }
+  
+  // Computes the spectra of the partitions of the impulse response. This
+  // runs one FFT per partition: call it outside of the audio processing, or
+  // between two blocks. The impulse response is truncated to the allocated
+  // partitions, that is to say to max_ir_size rounded up to a multiple of
+  // block_size.
+  void set_impulse_response(const float* ir, size_t size) {
+    size_t num_partitions = (size + block_size - 1) / block_size;
+    num_partitions = std::min(num_partitions, max_num_partitions_);
+    
+    // The 1 / fft_size scale of the inverse transform is applied here.
+    const float scale = 1.0f / static_cast<float>(fft_size);
+    for (size_t p = 0; p < num_partitions; ++p) {
+      size_t offset = p * block_size;
+      size_t count = std::min(size - offset, static_cast<size_t>(block_size));
+      for (size_t i = 0; i < count; ++i) {
+        fft_in_[i] = ir[offset + i] * scale;
+      }
+      std::fill(&fft_in_[count], &fft_in_[fft_size], 0.0f);
+      fft_.Direct(fft_in_, &ir_spectra_[p * fft_size]);
+    }
+    num_partitions_ = num_partitions;
+  }
+  
+  // size must be a multiple of block_size. in and out can be the same buffer.
+  void Process(const float* in, float* out, size_t size) {
+    assert(size % block_size == 0);
+    while (size) {
+      ProcessBlock(in, out);
+      in += block_size;
+      out += block_size;
+      size -= block_size;
+    }
+  }
+  
+  inline size_t num_partitions() const { return num_partitions_; }
+  
+ private:
+  void ProcessBlock(const float* in, float* out) {
+    if (!num_partitions_) {
+      std::fill(&out[0], &out[block_size], 0.0f);
+      return;
+    }
+    
+    // Slide the input frame by one block and add the new block to the
+    // frequency-domain delay line.
+    std::copy(&input_[block_size], &input_[fft_size], &input_[0]);
+    std::copy(&in[0], &in[block_size], &input_[block_size]);
+    std::copy(&input_[0], &input_[fft_size], &fft_in_[0]);
+    head_ = head_ == 0 ? max_num_partitions_ - 1 : head_ - 1;
+    fft_.Direct(fft_in_, &input_spectra_[head_ * fft_size]);
+    
+    std::fill(&fft_in_[0], &fft_in_[fft_size], 0.0f);
+    size_t slot = head_;
+    for (size_t p = 0; p < num_partitions_; ++p) {
+      SpectrumMultiplyAccumulate<fft_size>(
+          &input_spectra_[slot * fft_size],
+          &ir_spectra_[p * fft_size],
+          fft_in_);
+      if (++slot == max_num_partitions_) {
+        slot = 0;
+      }
+    }
+    
+    // The first half of the circular convolution is aliased.
+    fft_.Inverse(fft_in_, fft_out_);
+    std::copy(&fft_out_[block_size], &fft_out_[fft_size], &out[0]);
+  }
+  
+  ShyFFT<float, fft_size, LutPhasor> fft_;
+  
+  float* ir_spectra_;
+  float* input_spectra_;
+  float* input_;
+  float* fft_in_;
+  float* fft_out_;
+  
+  size_t max_num_partitions_;
+  size_t num_partitions_;
+  size_t head_;
+  
+  DISALLOW_COPY_AND_ASSIGN(PartitionedConvolver);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_PARTITIONED_CONVOLVER_H_
@@ -39,6 +39,8 @@
 
 #include "stmlib/stmlib.h"
 
+#include "stmlib/dsp/simd.h"
+
 #include <algorithm>
 #include <cmath>
 
@@ -100,6 +102,11 @@ class LutPhasor {
   LutPhasor() { }
   ~LutPhasor() { }
   
+  // Each entry is computed from its index, rather than by accumulating the
+  // phase, whose rounding made large transforms inaccurate. The tables of
+  // transforms of 32 points and more thus differ in their last bits from
+  // those of older versions, and so do the outputs (by 1e-6 relative at 1024
+  // points). RotationPhasor is unchanged.
   void Init() {
     Math<T> math;
   
@@ -107,10 +114,8 @@ class LutPhasor {
       size_t pass_size = 1L << (pass - 1);
       T* pass_ptr = &trig_lut_[(1L << (pass - 1)) - 4];
       T increment = math.pi() / (pass_size << 1);
-      T phase = 0.0;
       for (size_t i = 0; i < pass_size; ++i) {
-        pass_ptr[i] = math.cos(phase);
-        phase += increment;
+        pass_ptr[i] = math.cos(increment * static_cast<T>(i));
       }
     }
   }
@@ -129,6 +134,12 @@ class LutPhasor {
   inline T cos() const { return *cos_ptr_; }
   inline T sin() const { return *sin_ptr_; }
   
+  // cos(k * pi / 2^pass), for k in [0, 2^(pass - 1)[. The sines are read
+  // backwards from the same table.
+  inline const T* table(size_t pass) const {
+    return &trig_lut_[(1 << (pass - 1)) - 4];
+  }
+  
  private:
   T trig_lut_[(1 << (num_passes - 1)) - 4];
   T* cos_ptr_;
@@ -148,6 +159,7 @@ struct LutPhasor<T, 3> {
   void Rotate() { };
   inline T cos() const { return 1.0; }
   inline T sin() const { return 0.0; }
+  inline const T* table(size_t) const { return NULL; }
 };
 
 
@@ -206,147 +218,333 @@ struct RotationPhasor<T, 3> {
   inline T sin() const { return 0.0; }
 };
 
-// Direct transform
-template<typename T, size_t num_passes, typename Phasor>
-struct DirectTransform {
- private:
+// Butterflies of the passes >= 3, for one block of 2n values. The scalar
+// version computes the butterflies for j in [1, end[. T is the type of the
+// twiddle factors, V the type of the data - which can be a vector of T, to
+// transform several interleaved channels at once.
+template<typename T, typename Phasor, typename V = T>
+struct ScalarDirectButterflies {
+  inline void operator()(
+      const V* s1r, const V* s2r, const V* s1i, const V* s2i,
+      V* dr, V* di,
+      size_t n, size_t pass, Phasor* phasor, size_t end) const {
+    phasor->Start(pass);
+    for (size_t j = 1; j < end; ++j) {
+      T c = phasor->cos();
+      T s = phasor->sin();
+      V v;
+
+      v = s2r[j] * c - s2i[j] * s;
+      dr[j] = s1r[j] + v;
+      di[-j] = s1r[j] - v;
+
+      v = s2r[j] * s + s2i[j] * c;
+      di[j] = v + s1i[j];
+      di[n - j] = v - s1i[j];
+      phasor->Rotate();
+    }
+  }
+};
+
+template<typename T, typename Phasor, typename V = T>
+struct ScalarInverseButterflies {
+  inline void operator()(
+      const V* sr, const V* si,
+      V* d1r, V* d1i, V* d2r, V* d2i,
+      size_t n, size_t pass, Phasor* phasor, size_t end) const {
+    phasor->Start(pass);
+    for (size_t j = 1; j < end; ++j) {
+      d1r[j] = sr[j] + si[-j];
+      d1i[j] = si[j] - si[n - j];
+      
+      T c = phasor->cos();
+      T s = phasor->sin();
+      V vr = sr[j] - si[-j];
+      V vi = si[j] + si[n - j];
+      
+      d2r[j] = vr * c + vi * s;
+      d2i[j] = vi * c - vr * s;
+      phasor->Rotate();
+    }
+  }
+};
+
+template<typename T, typename Phasor, typename V = T>
+struct DirectButterflies {
+  inline void operator()(
+      const V* s1r, const V* s2r, const V* s1i, const V* s2i,
+      V* dr, V* di,
+      size_t n, size_t pass, Phasor* phasor) const {
+    ScalarDirectButterflies<T, Phasor, V> scalar;
+    scalar(s1r, s2r, s1i, s2i, dr, di, n, pass, phasor, n >> 1);
+  }
+};
+
+template<typename T, typename Phasor, typename V = T>
+struct InverseButterflies {
+  inline void operator()(
+      const V* sr, const V* si,
+      V* d1r, V* d1i, V* d2r, V* d2i,
+      size_t n, size_t pass, Phasor* phasor) const {
+    ScalarInverseButterflies<T, Phasor, V> scalar;
+    scalar(sr, si, d1r, d1i, d2r, d2i, n, pass, phasor, n >> 1);
+  }
+};
+
+#if STMLIB_SIMD_MAX_WIDTH >= 4
+
+// With a table phasor (which provides table(pass)), the twiddle factors for
+// consecutive values of j are contiguous in memory, so the butterflies can be
+// vectorized. The first width - 1 butterflies are computed by the scalar code.
+template<typename Phasor>
+struct TableDirectButterflies {
   enum {
-    size = 1 << num_passes
+    width = STMLIB_SIMD_MAX_WIDTH
   };
+  typedef typename FloatVector<width>::type Vector;
   
- public:
-  void operator()(
-      T* input,
-      T* output,
-      const uint8_t* bit_rev,
-      Phasor* phasor) {
-    T* s;
-    T* d;
-    Math<T> math;
+  inline void operator()(
+      const float* s1r, const float* s2r, const float* s1i, const float* s2i,
+      float* dr, float* di,
+      size_t n, size_t pass, Phasor* phasor) const {
+    size_t n_2 = n >> 1;
+    ScalarDirectButterflies<float, Phasor> scalar;
+    if (n_2 < 2 * width) {
+      scalar(s1r, s2r, s1i, s2i, dr, di, n, pass, phasor, n_2);
+      return;
+    }
+    scalar(s1r, s2r, s1i, s2i, dr, di, n, pass, phasor, width);
     
-    // First and second pass.
-    d = output;
-    for (size_t i = 0; i < size; i += 4) {
-      const T* s = input;
-      size_t r0 = num_passes <= 8
-          ? bit_rev[i >> 2]
-          : ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - num_passes);
-      size_t r1 = r0 + 2 * (size >> 2);
-      size_t r2 = r0 + 1 * (size >> 2);
-      size_t r3 = r0 + 3 * (size >> 2);
+    const float* lut = phasor->table(pass);
+    for (size_t j = width; j < n_2; j += width) {
+      Vector c = SimdLoad<Vector>(lut + j);
+      Vector s = SimdReverse(SimdLoad<Vector>(lut + n_2 - j - (width - 1)));
+      Vector s1r_j = SimdLoad<Vector>(s1r + j);
+      Vector s1i_j = SimdLoad<Vector>(s1i + j);
+      Vector s2r_j = SimdLoad<Vector>(s2r + j);
+      Vector s2i_j = SimdLoad<Vector>(s2i + j);
+      Vector v;
       
-      d[1] = s[r0] - s[r1];
-      d[3] = s[r2] - s[r3];
-      T a = s[r0] + s[r1];
-      T b = s[r2] + s[r3];
-      d[0] = a + b;
-      d[2] = a - b;
-      d += 4;
+      v = s2r_j * c - s2i_j * s;
+      SimdStore(dr + j, s1r_j + v);
+      SimdStore(di - j - (width - 1), SimdReverse(s1r_j - v));
+      
+      v = s2r_j * s + s2i_j * c;
+      SimdStore(di + j, v + s1i_j);
+      SimdStore(di + n - j - (width - 1), SimdReverse(v - s1i_j));
+    }
+  }
+};
+
+template<typename Phasor>
+struct TableInverseButterflies {
+  enum {
+    width = STMLIB_SIMD_MAX_WIDTH
+  };
+  typedef typename FloatVector<width>::type Vector;
+  
+  inline void operator()(
+      const float* sr, const float* si,
+      float* d1r, float* d1i, float* d2r, float* d2i,
+      size_t n, size_t pass, Phasor* phasor) const {
+    size_t n_2 = n >> 1;
+    ScalarInverseButterflies<float, Phasor> scalar;
+    if (n_2 < 2 * width) {
+      scalar(sr, si, d1r, d1i, d2r, d2i, n, pass, phasor, n_2);
+      return;
     }
+    scalar(sr, si, d1r, d1i, d2r, d2i, n, pass, phasor, width);
     
-    // Third pass.
-    s = output;
-    d = input;
-    for (size_t i = 0; i < size; i += 8) {
-      T v;
+    const float* lut = phasor->table(pass);
+    for (size_t j = width; j < n_2; j += width) {
+      Vector c = SimdLoad<Vector>(lut + j);
+      Vector s = SimdReverse(SimdLoad<Vector>(lut + n_2 - j - (width - 1)));
+      Vector sr_j = SimdLoad<Vector>(sr + j);
+      Vector si_j = SimdLoad<Vector>(si + j);
+      Vector si_minus_j = SimdReverse(
+          SimdLoad<Vector>(si - j - (width - 1)));
+      Vector si_n_minus_j = SimdReverse(
+          SimdLoad<Vector>(si + n - j - (width - 1)));
+      
+      SimdStore(d1r + j, sr_j + si_minus_j);
+      SimdStore(d1i + j, si_j - si_n_minus_j);
+      
+      Vector vr = sr_j - si_minus_j;
+      Vector vi = si_j + si_n_minus_j;
+      SimdStore(d2r + j, vr * c + vi * s);
+      SimdStore(d2i + j, vi * c - vr * s);
+    }
+  }
+};
 
-      d[i] = s[i] + s[i + 4];
-      d[i + 4] = s[i] - s[i + 4];
-      d[i + 2] = s[i + 2];
-      d[i + 6] = s[i + 6];
+template<size_t num_passes>
+struct DirectButterflies<float, LutPhasor<float, num_passes> >
+    : public TableDirectButterflies<LutPhasor<float, num_passes> > { };
 
-      v = (s[i + 5] - s[i + 7]) * math.sqrt_2_div_2();
-      d[i + 1] = s[i + 1] + v;
-      d[i + 3] = s[i + 1] - v;
+template<size_t num_passes>
+struct InverseButterflies<float, LutPhasor<float, num_passes> >
+    : public TableInverseButterflies<LutPhasor<float, num_passes> > { };
 
-      v = (s[i + 5] + s[i + 7]) * math.sqrt_2_div_2();
-      d[i + 5] = v + s[i + 3];
-      d[i + 7] = v - s[i + 3];
+#endif  // STMLIB_SIMD_MAX_WIDTH >= 4
+
+// Transforms larger than 2^SHY_FFT_CACHE_BLOCK_PASSES points are not computed
+// pass after pass over the whole buffer: the first passes are run on one
+// block of 2^SHY_FFT_CACHE_BLOCK_PASSES values at a time, while it stays in
+// the cache, and only the last passes sweep the whole buffer.
+enum {
+  SHY_FFT_CACHE_BLOCK_PASSES = 12
+};
+
+// Bit reversal of a num_bits-wide index, with a byte reversal LUT.
+inline size_t BitReverse(size_t x, size_t num_bits, const uint8_t* lut) {
+  uint32_t r = static_cast<uint32_t>(lut[x & 0xff]) << 24;
+  r |= static_cast<uint32_t>(lut[(x >> 8) & 0xff]) << 16;
+  r |= static_cast<uint32_t>(lut[(x >> 16) & 0xff]) << 8;
+  r |= static_cast<uint32_t>(lut[(x >> 24) & 0xff]);
+  return r >> (32 - num_bits);
+}
+
+// Calls visitor(m, r) for all num_bits-wide indices m, r being the bit
+// reversal of m. The indices are visited in tiles in which the low and high
+// bits of m vary, so that both m and r stay within a few cache lines.
+template<typename Visitor>
+inline void BitReversedTraversal(
+    size_t num_bits,
+    const uint8_t* lut,
+    Visitor* visitor) {
+  const size_t tile_bits = 4;
+  const size_t tile_size = 1 << tile_bits;
+  if (num_bits < 2 * tile_bits) {
+    for (size_t m = 0; m < (1UL << num_bits); ++m) {
+      (*visitor)(m, BitReverse(m, num_bits, lut));
     }
-    
-    // Remaining passes.
-    for (size_t pass = 3; pass < num_passes; ++pass) {
-      // Flip source and destination pointers
-      {
-        T* tmp = s;
-        s = d;
-        d = tmp;
+    return;
+  }
+  
+  size_t high_shift = num_bits - tile_bits;
+  size_t num_middle = 1 << (num_bits - 2 * tile_bits);
+  for (size_t b = 0; b < num_middle; ++b) {
+    for (size_t a = 0; a < tile_size; ++a) {
+      for (size_t c = 0; c < tile_size; ++c) {
+        size_t m = (a << high_shift) | (b << tile_bits) | c;
+        (*visitor)(m, BitReverse(m, num_bits, lut));
       }
-      
-      size_t n = 1 << pass;
-      size_t n_2 = n >> 1;
+    }
+  }
+}
 
-      for (size_t i = 0; i < size; i += (n << 1)) {
-        T* s1r = s + i;
-        T* s2r = s1r + n;
-        T* dr = d + i;
-        T* di = dr + n;
+// First and second pass of the direct transform, for the m-th group of 4
+// values, read from the bit-reversed location r.
+template<typename T>
+struct DirectFirstPasses {
+  const T* s;
+  T* d;
+  size_t quarter;
+  
+  inline void operator()(size_t m, size_t r0) const {
+    size_t r1 = r0 + 2 * quarter;
+    size_t r2 = r0 + 1 * quarter;
+    size_t r3 = r0 + 3 * quarter;
+    T* d_m = d + (m << 2);
+    
+    d_m[1] = s[r0] - s[r1];
+    d_m[3] = s[r2] - s[r3];
+    T a = s[r0] + s[r1];
+    T b = s[r2] + s[r3];
+    d_m[0] = a + b;
+    d_m[2] = a - b;
+  }
+};
 
-        dr[0] = s1r[0] + s2r[0];
-        di[0] = s1r[0] - s2r[0];
-        dr[n_2] = s1r[n_2];
-        di[n_2] = s2r[n_2];
-        T* s1i = s1r + n_2;
-        T* s2i = s1i + n;
-        phasor->Start(pass);
-        for (size_t j = 1; j < n_2; ++j) {
-          T c = phasor->cos();
-          T s = phasor->sin();
-          T v;
-
-          v = s2r[j] * c - s2i[j] * s;
-          dr[j] = s1r[j] + v;
-          di[-j] = s1r[j] - v;
-
-          v = s2r[j] * s + s2i[j] * c;
-          di[j] = v + s1i[j];
-          di[n - j] = v - s1i[j];
-          phasor->Rotate();
-        }
+// Second and first pass of the inverse transform, for the m-th group of 4
+// values, written to the bit-reversed location r.
+template<typename T, typename V = T>
+struct InverseLastPasses {
+  const V* s;
+  V* d;
+  size_t quarter;
+  
+  inline void operator()(size_t m, size_t r0) const {
+    size_t r1 = r0 + 2 * quarter;
+    size_t r2 = r0 + 1 * quarter;
+    size_t r3 = r0 + 3 * quarter;
+    const V* s_m = s + (m << 2);
+    
+    V b_0 = s_m[0] + s_m[2];
+    V b_2 = s_m[0] - s_m[2];
+    V b_1 = s_m[1] * T(2);
+    V b_3 = s_m[3] * T(2);
+    
+    d[r0] = b_0 + b_1;
+    d[r1] = b_0 - b_1;
+    d[r2] = b_2 + b_3;
+    d[r3] = b_2 - b_3;
+  }
+};
+
+// Direct transform
+template<typename T, size_t num_passes, typename Phasor, typename V = T>
+struct DirectTransform {
+ private:
+  enum {
+    size = 1 << num_passes
+  };
+  
+ public:
+  void operator()(
+      V* input,
+      V* output,
+      const uint8_t* bit_rev,
+      Phasor* phasor) {
+    // First and second pass.
+    if (num_passes <= 8) {
+      V* d = output;
+      for (size_t i = 0; i < size; i += 4) {
+        const V* s = input;
+        size_t r0 = bit_rev[i >> 2];
+        size_t r1 = r0 + 2 * (size >> 2);
+        size_t r2 = r0 + 1 * (size >> 2);
+        size_t r3 = r0 + 3 * (size >> 2);
+      
+        d[1] = s[r0] - s[r1];
+        d[3] = s[r2] - s[r3];
+        V a = s[r0] + s[r1];
+        V b = s[r2] + s[r3];
+        d[0] = a + b;
+        d[2] = a - b;
+        d += 4;
       }
+    } else {
+      DirectFirstPasses<V> first_passes = { input, output, size >> 2 };
+      BitReversedTraversal(num_passes - 2, bit_rev, &first_passes);
     }
     
-    // Annoying additional data copy step.
-    if (d != output) {
-      std::copy(&d[0], &d[size], &output[0]);
-    }
+    ThirdPass(output, input, size);
+    RemainingPasses(input, output, size, num_passes, phasor);
   }
   
   // The exact same thing but with "num_passes" as a run-time argument.
   void operator()(
-      T* input,
-      T* output,
+      V* input,
+      V* output,
       const uint8_t* bit_rev,
       Phasor* phasor,
       size_t rt_num_passes) {
-    T* s;
-    T* d;
-    Math<T> math;
     size_t rt_size = 1 << rt_num_passes;
+    
     // First and second pass.
-    d = output;
-    for (size_t i = 0; i < rt_size; i += 4) {
-      const T* s = input;
-      size_t r0 = \
-          ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - rt_num_passes);
-      size_t r1 = r0 + 2 * (rt_size >> 2);
-      size_t r2 = r0 + 1 * (rt_size >> 2);
-      size_t r3 = r0 + 3 * (rt_size >> 2);
-      
-      d[1] = s[r0] - s[r1];
-      d[3] = s[r2] - s[r3];
-      T a = s[r0] + s[r1];
-      T b = s[r2] + s[r3];
-      d[0] = a + b;
-      d[2] = a - b;
-      d += 4;
-    }
+    DirectFirstPasses<V> first_passes = { input, output, rt_size >> 2 };
+    BitReversedTraversal(rt_num_passes - 2, bit_rev, &first_passes);
     
-    // Third pass.
-    s = output;
-    d = input;
+    ThirdPass(output, input, rt_size);
+    RemainingPasses(input, output, rt_size, rt_num_passes, phasor);
+  }
+  
+ private:
+  inline void ThirdPass(const V* s, V* d, size_t rt_size) {
+    Math<T> math;
     for (size_t i = 0; i < rt_size; i += 8) {
-      T v;
+      V v;
 
       d[i] = s[i] + s[i + 4];
       d[i + 4] = s[i] - s[i + 4];
@@ -361,48 +559,76 @@ struct DirectTransform {
       d[i + 5] = v + s[i + 3];
       d[i + 7] = v - s[i + 3];
     }
-    
-    // Remaining passes.
-    for (size_t pass = 3; pass < rt_num_passes; ++pass) {
+  }
+  
+  // Passes [first_pass, last_pass[ on the values [begin, end[, flipping the
+  // source and destination pointers before each pass.
+  inline void Passes(
+      V** s,
+      V** d,
+      size_t begin,
+      size_t end,
+      size_t first_pass,
+      size_t last_pass,
+      Phasor* phasor) {
+    for (size_t pass = first_pass; pass < last_pass; ++pass) {
       // Flip source and destination pointers
       {
-        T* tmp = s;
-        s = d;
-        d = tmp;
+        V* tmp = *s;
+        *s = *d;
+        *d = tmp;
       }
       
       size_t n = 1 << pass;
       size_t n_2 = n >> 1;
 
-      for (size_t i = 0; i < rt_size; i += (n << 1)) {
-        T* s1r = s + i;
-        T* s2r = s1r + n;
-        T* dr = d + i;
-        T* di = dr + n;
+      for (size_t i = begin; i < end; i += (n << 1)) {
+        V* s1r = *s + i;
+        V* s2r = s1r + n;
+        V* dr = *d + i;
+        V* di = dr + n;
 
         dr[0] = s1r[0] + s2r[0];
         di[0] = s1r[0] - s2r[0];
         dr[n_2] = s1r[n_2];
         di[n_2] = s2r[n_2];
-        T* s1i = s1r + n_2;
-        T* s2i = s1i + n;
-        phasor->Start(pass);
-        for (size_t j = 1; j < n_2; ++j) {
-          T c = phasor->cos();
-          T s = phasor->sin();
-          T v;
-
-          v = s2r[j] * c - s2i[j] * s;
-          dr[j] = s1r[j] + v;
-          di[-j] = s1r[j] - v;
-
-          v = s2r[j] * s + s2i[j] * c;
-          di[j] = v + s1i[j];
-          di[n - j] = v - s1i[j];
-          phasor->Rotate();
-        }
+        V* s1i = s1r + n_2;
+        V* s2i = s1i + n;
+        DirectButterflies<T, Phasor, V> butterflies;
+        butterflies(s1r, s2r, s1i, s2i, dr, di, n, pass, phasor);
       }
     }
+  }
+  
+  // The data is in input after the third pass.
+  inline void RemainingPasses(
+      V* input,
+      V* output,
+      size_t rt_size,
+      size_t rt_num_passes,
+      Phasor* phasor) {
+    V* s = output;
+    V* d = input;
+    
+    size_t block_passes = std::min(
+        rt_num_passes,
+        static_cast<size_t>(SHY_FFT_CACHE_BLOCK_PASSES));
+    size_t block_size = 1 << block_passes;
+    for (size_t block = 0; block < rt_size; block += block_size) {
+      V* block_s = s;
+      V* block_d = d;
+      Passes(
+          &block_s, &block_d,
+          block, block + block_size,
+          3, block_passes,
+          phasor);
+    }
+    if ((block_passes - 3) & 1) {
+      V* tmp = s;
+      s = d;
+      d = tmp;
+    }
+    Passes(&s, &d, 0, rt_size, block_passes, rt_num_passes, phasor);
     
     // Annoying additional data copy step.
     if (d != output) {
@@ -411,28 +637,28 @@ struct DirectTransform {
   }
 };
 
-template<typename T, typename Phasor>
-struct DirectTransform<T, 0, Phasor> {
-  void operator()(const T* i, T* o, T*, const uint8_t*, Phasor*) {
+template<typename T, typename Phasor, typename V>
+struct DirectTransform<T, 0, Phasor, V> {
+  void operator()(const V* i, V* o, V*, const uint8_t*, Phasor*) {
     o[0] = i[0];
   }
 };
 
-template<typename T, typename Phasor>
-struct DirectTransform<T, 1, Phasor> {
-  void operator()(const T* i, T* o, T*, const uint8_t*, Phasor*) {
+template<typename T, typename Phasor, typename V>
+struct DirectTransform<T, 1, Phasor, V> {
+  void operator()(const V* i, V* o, V*, const uint8_t*, Phasor*) {
     o[0] = i[0] + i[1];
     o[1] = i[0] - i[1];
   }
 };
 
-template<typename T, typename Phasor>
-struct DirectTransform<T, 2, Phasor> {
-  void operator()(const T* i, T* o, T*, const uint8_t*, Phasor*) {
+template<typename T, typename Phasor, typename V>
+struct DirectTransform<T, 2, Phasor, V> {
+  void operator()(const V* i, V* o, V*, const uint8_t*, Phasor*) {
     o[1] = i[0] - i[2];
     o[3] = i[1] - i[3];
-    T a = i[0] + i[2];
-    T b = i[1] + i[3];
+    V a = i[0] + i[2];
+    V b = i[1] + i[3];
     o[0] = a + b;
     o[2] = a - b;
   }
@@ -440,7 +666,7 @@ struct DirectTransform<T, 2, Phasor> {
 
 
 // Inverse transform
-template<typename T, size_t num_passes, typename Phasor>
+template<typename T, size_t num_passes, typename Phasor, typename V = T>
 struct InverseTransform {
  private:
   enum {
@@ -449,67 +675,61 @@ struct InverseTransform {
   
  public:
   void operator()(
-      T* input,
-      T* output,
+      V* input,
+      V* output,
       const uint8_t* bit_rev,
       Phasor* phasor) {
-    T* s = (T*)(input);
-    T* d = output;
-    Math<T> math;
+    RemainingPasses(input, output, size, num_passes, phasor);
+    ThirdPass(output, input, size);
     
-    // Remaining passes.
-    for (size_t pass = num_passes - 1; pass >= 3; --pass) {
-      size_t n = 1 << pass;
-      size_t n_2 = n >> 1;
+    // Second and first pass.
+    if (num_passes <= 8) {
+      const V* s = input;
+      V* d = output;
+      for (size_t i = 0; i < size; i += 4) {
+        size_t r0 = bit_rev[i >> 2];
+        size_t r1 = r0 + 2 * (size >> 2);
+        size_t r2 = r0 + 1 * (size >> 2);
+        size_t r3 = r0 + 3 * (size >> 2);
       
-      for (size_t i = 0; i < size; i += (n << 1)) {
-        T* sr = s + i;
-        T* si = sr + n;
-        T* d1r = d + i;
-        T* d2r = d1r + n;
-        
-        d1r[0] = sr[0] + si[0];
-        d2r[0] = sr[0] - si[0];
-        d1r[n_2] = sr[n_2] * T(2);
-        d2r[n_2] = si[n_2] * T(2);
+        V b_0 = s[0] + s[2];
+        V b_2 = s[0] - s[2];
+        V b_1 = s[1] * T(2);
+        V b_3 = s[3] * T(2);
       
-        T* d1i = d1r + n_2;
-        T* d2i = d1i + n;
-        phasor->Start(pass);
-        for (size_t j = 1; j < n_2; ++j) {
-          d1r[j] = sr[j] + si[-j];
-          d1i[j] = si[j] - si[n - j];
-          
-          T c = phasor->cos();
-          T s = phasor->sin();
-          T vr = sr[j] - si[-j];
-          T vi = si[j] + si[n - j];
-          
-          d2r[j] = vr * c + vi * s;
-          d2i[j] = vi * c - vr * s;
-          phasor->Rotate();
-        }
-      }
-
-      // Flip source and destination pointers for the next pass.
-      if (d == output) {
-        s = output;
-        d = input;
-      } else {
-        s = input;
-        d = output;
+        d[r0] = b_0 + b_1;
+        d[r1] = b_0 - b_1;
+        d[r2] = b_2 + b_3;
+        d[r3] = b_2 - b_3;
+        s += 4;
       }
+    } else {
+      InverseLastPasses<T, V> last_passes = { input, output, size >> 2 };
+      BitReversedTraversal(num_passes - 2, bit_rev, &last_passes);
     }
+  }
+  
+  void operator()(
+      V* input,
+      V* output,
+      const uint8_t* bit_rev,
+      Phasor* phasor,
+      size_t rt_num_passes) {
+    size_t rt_size = 1 << rt_num_passes;
     
-    // Copy data if necessary.
-    if (d == output) {
-      std::copy(&s[0], &s[size], &output[0]);
-    }
+    RemainingPasses(input, output, rt_size, rt_num_passes, phasor);
+    ThirdPass(output, input, rt_size);
     
-    s = output;
-    d = input;
-    for (size_t i = 0; i < size; i += 8) {
-      T vr, vi;
+    // Second and first pass.
+    InverseLastPasses<T, V> last_passes = { input, output, rt_size >> 2 };
+    BitReversedTraversal(rt_num_passes - 2, bit_rev, &last_passes);
+  }
+  
+ private:
+  inline void ThirdPass(const V* s, V* d, size_t rt_size) {
+    Math<T> math;
+    for (size_t i = 0; i < rt_size; i += 8) {
+      V vr, vi;
       d[i] = s[i] + s[i + 4];
       d[i + 4] = s[i] - s[i + 4];
       d[i + 2] = s[i + 2] * T(2);
@@ -521,152 +741,103 @@ struct InverseTransform {
       d[i + 5] = (vr + vi) * math.sqrt_2_div_2();
       d[i + 7] = (vi - vr) * math.sqrt_2_div_2();
     }
-    
-    // First and second pass.
-    s = input;
-    d = output;
-    for (size_t i = 0; i < size; i += 4) {
-      size_t r0 = num_passes <= 8
-          ? bit_rev[i >> 2]
-          : ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - num_passes);
-      size_t r1 = r0 + 2 * (size >> 2);
-      size_t r2 = r0 + 1 * (size >> 2);
-      size_t r3 = r0 + 3 * (size >> 2);
-      
-      T b_0 = s[0] + s[2];
-      T b_2 = s[0] - s[2];
-      T b_1 = s[1] * T(2);
-      T b_3 = s[3] * T(2);
-      
-      d[r0] = b_0 + b_1;
-      d[r1] = b_0 - b_1;
-      d[r2] = b_2 + b_3;
-      d[r3] = b_2 - b_3;
-      s += 4;
-    }
   }
   
-  void operator()(
-      T* input,
-      T* output,
-      const uint8_t* bit_rev,
-      Phasor* phasor,
-      size_t rt_num_passes) {
-    T* s = (T*)(input);
-    T* d = output;
-    Math<T> math;
-    
-    size_t rt_size = 1 << rt_num_passes;
-    
-    // Remaining passes.
-    for (size_t pass = rt_num_passes - 1; pass >= 3; --pass) {
+  // Passes first_pass down to last_pass on the values [begin, end[, flipping
+  // the source and destination pointers after each pass.
+  inline void Passes(
+      V** s,
+      V** d,
+      size_t begin,
+      size_t end,
+      size_t first_pass,
+      size_t last_pass,
+      Phasor* phasor) {
+    for (size_t pass = first_pass; pass >= last_pass; --pass) {
       size_t n = 1 << pass;
       size_t n_2 = n >> 1;
       
-      for (size_t i = 0; i < rt_size; i += (n << 1)) {
-        T* sr = s + i;
-        T* si = sr + n;
-        T* d1r = d + i;
-        T* d2r = d1r + n;
+      for (size_t i = begin; i < end; i += (n << 1)) {
+        V* sr = *s + i;
+        V* si = sr + n;
+        V* d1r = *d + i;
+        V* d2r = d1r + n;
         
         d1r[0] = sr[0] + si[0];
         d2r[0] = sr[0] - si[0];
         d1r[n_2] = sr[n_2] * T(2);
         d2r[n_2] = si[n_2] * T(2);
       
-        T* d1i = d1r + n_2;
-        T* d2i = d1i + n;
-        phasor->Start(pass);
-        for (size_t j = 1; j < n_2; ++j) {
-          d1r[j] = sr[j] + si[-j];
-          d1i[j] = si[j] - si[n - j];
-          
-          T c = phasor->cos();
-          T s = phasor->sin();
-          T vr = sr[j] - si[-j];
-          T vi = si[j] + si[n - j];
-          
-          d2r[j] = vr * c + vi * s;
-          d2i[j] = vi * c - vr * s;
-          phasor->Rotate();
-        }
+        V* d1i = d1r + n_2;
+        V* d2i = d1i + n;
+        InverseButterflies<T, Phasor, V> butterflies;
+        butterflies(sr, si, d1r, d1i, d2r, d2i, n, pass, phasor);
       }
 
       // Flip source and destination pointers for the next pass.
-      if (d == output) {
-        s = output;
-        d = input;
-      } else {
-        s = input;
-        d = output;
-      }
+      V* tmp = *s;
+      *s = *d;
+      *d = tmp;
     }
+  }
+  
+  // Leaves the data in output, for the third pass.
+  inline void RemainingPasses(
+      V* input,
+      V* output,
+      size_t rt_size,
+      size_t rt_num_passes,
+      Phasor* phasor) {
+    V* s = input;
+    V* d = output;
     
-    // Copy data if necessary.
-    if (d == output) {
-      std::copy(&s[0], &s[rt_size], &output[0]);
+    size_t block_passes = std::min(
+        rt_num_passes,
+        static_cast<size_t>(SHY_FFT_CACHE_BLOCK_PASSES));
+    size_t block_size = 1 << block_passes;
+    Passes(&s, &d, 0, rt_size, rt_num_passes - 1, block_passes, phasor);
+    for (size_t block = 0; block < rt_size; block += block_size) {
+      V* block_s = s;
+      V* block_d = d;
+      Passes(
+          &block_s, &block_d,
+          block, block + block_size,
+          block_passes - 1, 3,
+          phasor);
     }
-    
-    s = output;
-    d = input;
-    for (size_t i = 0; i < rt_size; i += 8) {
-      T vr, vi;
-      d[i] = s[i] + s[i + 4];
-      d[i + 4] = s[i] - s[i + 4];
-      d[i + 2] = s[i + 2] * T(2);
-      d[i + 6] = s[i + 6] * T(2);
-      d[i + 1] = s[i + 1] + s[i + 3];
-      d[i + 3] = s[i + 5] - s[i + 7];
-      vr = s[i + 1] - s[i + 3];
-      vi = s[i + 5] + s[i + 7];
-      d[i + 5] = (vr + vi) * math.sqrt_2_div_2();
-      d[i + 7] = (vi - vr) * math.sqrt_2_div_2();
+    if ((block_passes - 3) & 1) {
+      V* tmp = s;
+      s = d;
+      d = tmp;
     }
     
-    // First and second pass.
-    s = input;
-    d = output;
-    for (size_t i = 0; i < rt_size; i += 4) {
-      size_t r0 = \
-            ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - rt_num_passes);
-      size_t r1 = r0 + 2 * (rt_size >> 2);
-      size_t r2 = r0 + 1 * (rt_size >> 2);
-      size_t r3 = r0 + 3 * (rt_size >> 2);
-      
-      T b_0 = s[0] + s[2];
-      T b_2 = s[0] - s[2];
-      T b_1 = s[1] * T(2);
-      T b_3 = s[3] * T(2);
-      
-      d[r0] = b_0 + b_1;
-      d[r1] = b_0 - b_1;
-      d[r2] = b_2 + b_3;
-      d[r3] = b_2 - b_3;
-      s += 4;
+    // Copy data if necessary.
+    if (d == output) {
+      std::copy(&s[0], &s[rt_size], &output[0]);
     }
   }
 };
 
-template<typename T, typename Phasor>
-struct InverseTransform<T, 0, Phasor> {
-  void operator()(const T* i, T* o, T*, const uint8_t*, Phasor*) {
+template<typename T, typename Phasor, typename V>
+struct InverseTransform<T, 0, Phasor, V> {
+  void operator()(const V* i, V* o, V*, const uint8_t*, Phasor*) {
     o[0] = i[0];
   }
 };
 
-template<typename T, typename Phasor>
-struct InverseTransform<T, 1, Phasor> {
-  void operator()(const T* i, T* o, T*, const uint8_t*, Phasor*) {
+template<typename T, typename Phasor, typename V>
+struct InverseTransform<T, 1, Phasor, V> {
+  void operator()(const V* i, V* o, V*, const uint8_t*, Phasor*) {
     o[0] = i[0] + i[1];
     o[1] = i[0] - i[1];
   }
 };
 
-template<typename T, typename Phasor>
-struct InverseTransform<T, 2, Phasor> {
-  void operator()(const T* i, T* o, T*, const uint8_t*, Phasor*) {
-    T a = i[0] + i[2];
-    T b = i[0] - i[2];
+template<typename T, typename Phasor, typename V>
+struct InverseTransform<T, 2, Phasor, V> {
+  void operator()(const V* i, V* o, V*, const uint8_t*, Phasor*) {
+    V a = i[0] + i[2];
+    V b = i[0] - i[2];
     
     o[0] = a + i[1] * T(2);
     o[2] = a - i[1] * T(2);
@@ -730,6 +901,34 @@ class ShyFFT {
         &phasor_);
   }
   
+  // Transforms num_channels frames at once. The frames are interleaved, with
+  // sample i of channel c at input[i * num_channels + c]: each twiddle factor
+  // is loaded once for all the channels, and the channels are processed by
+  // the lanes of SIMD vectors. Only for T = float. num_channels must be a
+  // power of 2, and the buffers aligned on the native vector size. The
+  // output spectra are interleaved the same way.
+  template<size_t num_channels>
+  void DirectBatch(T* input, T* output) {
+    typedef FloatLanes<num_channels> V;
+    DirectTransform<T, num_passes, Phasor<T, num_passes>, V> d;
+    d(
+        reinterpret_cast<V*>(input),
+        reinterpret_cast<V*>(output),
+        num_passes <= 8 ? &bit_rev_[0] : bit_rev_256_lut_,
+        &phasor_);
+  }
+  
+  template<size_t num_channels>
+  void InverseBatch(T* input, T* output) {
+    typedef FloatLanes<num_channels> V;
+    InverseTransform<T, num_passes, Phasor<T, num_passes>, V> i;
+    i(
+        reinterpret_cast<V*>(input),
+        reinterpret_cast<V*>(output),
+        num_passes <= 8 ? &bit_rev_[0] : bit_rev_256_lut_,
+        &phasor_);
+  }
+  
   void Direct(T* input, T* output, size_t n) {
     DirectTransform<T, num_passes, Phasor<T, num_passes> > d;
     d(
@@ -767,6 +966,342 @@ const uint8_t ShyFFT<T, size, Phasor>::bit_rev_256_lut_[256] = {
 R6(0), R6(2), R6(1), R6(3)
 };
 
+// Fixed-point version, for the parts without FPU. The values are int32_t, and
+// the transform uses block floating point: before each pass, the data is
+// shifted right by the number of bits needed to keep two bits of headroom, so
+// that the pass cannot overflow, and the shifts are accumulated in an
+// exponent returned by Direct() and Inverse(): the float transform of the
+// same data is output * 2^exponent. The input is first normalized (shifted
+// left if needed), so 16-bit samples can be passed as they are.
+//
+// The twiddle factors are a Q31 table computed by Init() - the Phasor template
+// argument is not used. size must be at least 16.
+template<size_t size, template <typename, size_t> class Phasor>
+class ShyFFT<int32_t, size, Phasor> {
+ public:
+  enum {
+    num_passes = Log2<size>::value,
+    max_size = size
+  };
+  
+  STATIC_ASSERT(num_passes >= 4, size_must_be_at_least_16);
+
+  ShyFFT() { }
+  ~ShyFFT() { }
+  
+  void Init() {
+    for (size_t pass = 3; pass < num_passes; ++pass) {
+      size_t pass_size = 1L << (pass - 1);
+      int32_t* pass_ptr = &trig_lut_[pass_size - 4];
+      double increment = 3.141592653589793 / (pass_size << 1);
+      for (size_t i = 0; i < pass_size; ++i) {
+        // cos(0) = 1.0 does not fit in Q31, but it is never used by the
+        // butterflies (j >= 1).
+        double c = std::cos(increment * static_cast<double>(i));
+        pass_ptr[i] = i == 0
+            ? 0x7fffffff
+            : static_cast<int32_t>(c * 2147483648.0 + 0.5);
+      }
+    }
+  }
+  
+  int Direct(int32_t* input, int32_t* output) {
+    int exponent = Normalize(input);
+    
+    // First and second pass.
+    const size_t quarter = size >> 2;
+    uint32_t bits = 0;
+    size_t r0 = 0;
+    int32_t* d = output;
+    for (size_t m = 0; m < quarter; ++m) {
+      const int32_t* s = input;
+      size_t r1 = r0 + 2 * quarter;
+      size_t r2 = r0 + 1 * quarter;
+      size_t r3 = r0 + 3 * quarter;
+      
+      d[1] = s[r0] - s[r1];
+      d[3] = s[r2] - s[r3];
+      int32_t a = s[r0] + s[r1];
+      int32_t b = s[r2] + s[r3];
+      d[0] = a + b;
+      d[2] = a - b;
+      bits |= Magnitude(d[0]) | Magnitude(d[1]) | \
+          Magnitude(d[2]) | Magnitude(d[3]);
+      d += 4;
+      r0 = NextBitReversed(r0, quarter);
+    }
+    
+    // Third pass.
+    int shift = Headroom(bits);
+    exponent += shift;
+    bits = 0;
+    {
+      const int32_t* s = output;
+      d = input;
+      for (size_t i = 0; i < size; i += 8) {
+        int32_t s0 = s[i] >> shift;
+        int32_t s1 = s[i + 1] >> shift;
+        int32_t s3 = s[i + 3] >> shift;
+        int32_t s4 = s[i + 4] >> shift;
+        int32_t s5 = s[i + 5] >> shift;
+        int32_t s7 = s[i + 7] >> shift;
+        int32_t v;
+        
+        d[i] = s0 + s4;
+        d[i + 4] = s0 - s4;
+        d[i + 2] = s[i + 2] >> shift;
+        d[i + 6] = s[i + 6] >> shift;
+        
+        v = Multiply(s5 - s7, kSqrt2Div2);
+        d[i + 1] = s1 + v;
+        d[i + 3] = s1 - v;
+        
+        v = Multiply(s5 + s7, kSqrt2Div2);
+        d[i + 5] = v + s3;
+        d[i + 7] = v - s3;
+        for (size_t k = 0; k < 8; ++k) {
+          bits |= Magnitude(d[i + k]);
+        }
+      }
+    }
+    
+    int32_t* s = input;
+    d = output;
+    for (size_t pass = 3; pass < num_passes; ++pass) {
+      shift = Headroom(bits);
+      exponent += shift;
+      bits = 0;
+      
+      size_t n = 1 << pass;
+      size_t n_2 = n >> 1;
+      const int32_t* cos_lut = &trig_lut_[n_2 - 4];
+      const int32_t* sin_lut = &trig_lut_[n - 4];
+      for (size_t i = 0; i < size; i += (n << 1)) {
+        const int32_t* s1r = s + i;
+        const int32_t* s2r = s1r + n;
+        const int32_t* s1i = s1r + n_2;
+        const int32_t* s2i = s1i + n;
+        int32_t* dr = d + i;
+        int32_t* di = dr + n;
+        
+        dr[0] = (s1r[0] >> shift) + (s2r[0] >> shift);
+        di[0] = (s1r[0] >> shift) - (s2r[0] >> shift);
+        dr[n_2] = s1r[n_2] >> shift;
+        di[n_2] = s2r[n_2] >> shift;
+        bits |= Magnitude(dr[0]) | Magnitude(di[0]) | \
+            Magnitude(dr[n_2]) | Magnitude(di[n_2]);
+        for (size_t j = 1; j < n_2; ++j) {
+          int32_t cosine = cos_lut[j];
+          int32_t sine = sin_lut[-j];
+          int32_t s1r_j = s1r[j] >> shift;
+          int32_t s1i_j = s1i[j] >> shift;
+          int32_t s2r_j = s2r[j] >> shift;
+          int32_t s2i_j = s2i[j] >> shift;
+          int32_t v;
+          
+          v = MultiplyAdd(s2r_j, cosine, -s2i_j, sine);
+          dr[j] = s1r_j + v;
+          di[-j] = s1r_j - v;
+          
+          v = MultiplyAdd(s2r_j, sine, s2i_j, cosine);
+          di[j] = v + s1i_j;
+          di[n - j] = v - s1i_j;
+          bits |= Magnitude(dr[j]) | Magnitude(di[-j]) | \
+              Magnitude(di[j]) | Magnitude(di[n - j]);
+        }
+      }
+      
+      int32_t* tmp = s;
+      s = d;
+      d = tmp;
+    }
+    
+    if (s != output) {
+      std::copy(&s[0], &s[size], &output[0]);
+    }
+    return exponent;
+  }
+  
+  int Inverse(int32_t* input, int32_t* output) {
+    int exponent = Normalize(input);
+    uint32_t bits = 0;
+    int shift = 0;
+    
+    int32_t* s = input;
+    int32_t* d = output;
+    for (size_t pass = num_passes - 1; pass >= 3; --pass) {
+      size_t n = 1 << pass;
+      size_t n_2 = n >> 1;
+      const int32_t* cos_lut = &trig_lut_[n_2 - 4];
+      const int32_t* sin_lut = &trig_lut_[n - 4];
+      for (size_t i = 0; i < size; i += (n << 1)) {
+        const int32_t* sr = s + i;
+        const int32_t* si = sr + n;
+        int32_t* d1r = d + i;
+        int32_t* d2r = d1r + n;
+        int32_t* d1i = d1r + n_2;
+        int32_t* d2i = d1i + n;
+        
+        d1r[0] = (sr[0] >> shift) + (si[0] >> shift);
+        d2r[0] = (sr[0] >> shift) - (si[0] >> shift);
+        d1r[n_2] = (sr[n_2] >> shift) * 2;
+        d2r[n_2] = (si[n_2] >> shift) * 2;
+        bits |= Magnitude(d1r[0]) | Magnitude(d2r[0]) | \
+            Magnitude(d1r[n_2]) | Magnitude(d2r[n_2]);
+        for (size_t j = 1; j < n_2; ++j) {
+          int32_t sr_j = sr[j] >> shift;
+          int32_t si_j = si[j] >> shift;
+          int32_t si_minus_j = si[-j] >> shift;
+          int32_t si_n_minus_j = si[n - j] >> shift;
+          
+          d1r[j] = sr_j + si_minus_j;
+          d1i[j] = si_j - si_n_minus_j;
+          
+          int32_t cosine = cos_lut[j];
+          int32_t sine = sin_lut[-j];
+          int32_t vr = sr_j - si_minus_j;
+          int32_t vi = si_j + si_n_minus_j;
+          d2r[j] = MultiplyAdd(vr, cosine, vi, sine);
+          d2i[j] = MultiplyAdd(vi, cosine, -vr, sine);
+          bits |= Magnitude(d1r[j]) | Magnitude(d1i[j]) | \
+              Magnitude(d2r[j]) | Magnitude(d2i[j]);
+        }
+      }
+      
+      int32_t* tmp = s;
+      s = d;
+      d = tmp;
+      shift = Headroom(bits);
+      exponent += shift;
+      bits = 0;
+    }
+    
+    // Third pass.
+    d = s == input ? output : input;
+    for (size_t i = 0; i < size; i += 8) {
+      int32_t s1 = s[i + 1] >> shift;
+      int32_t s3 = s[i + 3] >> shift;
+      int32_t s5 = s[i + 5] >> shift;
+      int32_t s7 = s[i + 7] >> shift;
+      int32_t vr = s1 - s3;
+      int32_t vi = s5 + s7;
+      
+      d[i] = (s[i] >> shift) + (s[i + 4] >> shift);
+      d[i + 4] = (s[i] >> shift) - (s[i + 4] >> shift);
+      d[i + 2] = (s[i + 2] >> shift) * 2;
+      d[i + 6] = (s[i + 6] >> shift) * 2;
+      d[i + 1] = s1 + s3;
+      d[i + 3] = s5 - s7;
+      d[i + 5] = Multiply(vr + vi, kSqrt2Div2);
+      d[i + 7] = Multiply(vi - vr, kSqrt2Div2);
+      for (size_t k = 0; k < 8; ++k) {
+        bits |= Magnitude(d[i + k]);
+      }
+    }
+    
+    // Second and first pass, which must write to output.
+    if (d == output) {
+      std::copy(&output[0], &output[size], &input[0]);
+    }
+    s = input;
+    d = output;
+    shift = Headroom(bits);
+    exponent += shift;
+    
+    const size_t quarter = size >> 2;
+    size_t r0 = 0;
+    for (size_t m = 0; m < quarter; ++m) {
+      size_t r1 = r0 + 2 * quarter;
+      size_t r2 = r0 + 1 * quarter;
+      size_t r3 = r0 + 3 * quarter;
+      const int32_t* s_m = s + (m << 2);
+      
+      int32_t b_0 = (s_m[0] >> shift) + (s_m[2] >> shift);
+      int32_t b_2 = (s_m[0] >> shift) - (s_m[2] >> shift);
+      int32_t b_1 = (s_m[1] >> shift) * 2;
+      int32_t b_3 = (s_m[3] >> shift) * 2;
+      
+      d[r0] = b_0 + b_1;
+      d[r1] = b_0 - b_1;
+      d[r2] = b_2 + b_3;
+      d[r3] = b_2 - b_3;
+      r0 = NextBitReversed(r0, quarter);
+    }
+    return exponent;
+  }
+  
+ private:
+  enum {
+    // Each pass can grow the values by a factor of up to 4.
+    kMaxMagnitudeBits = 29
+  };
+  
+  static const int32_t kSqrt2Div2 = 1518500250;
+  
+  // |x| for positive values, |x| - 1 for negative values.
+  static inline uint32_t Magnitude(int32_t x) {
+    return static_cast<uint32_t>(x ^ (x >> 31));
+  }
+  
+  static inline int NumBits(uint32_t bits) {
+    return bits ? 32 - __builtin_clz(bits) : 0;
+  }
+  
+  // Right shift to apply to a block of values so that they fit in
+  // kMaxMagnitudeBits.
+  static inline int Headroom(uint32_t bits) {
+    int shift = NumBits(bits) - kMaxMagnitudeBits;
+    return shift > 0 ? shift : 0;
+  }
+  
+  // Scales the input so that it uses kMaxMagnitudeBits.
+  static inline int Normalize(int32_t* data) {
+    uint32_t bits = 0;
+    for (size_t i = 0; i < size; ++i) {
+      bits |= Magnitude(data[i]);
+    }
+    int shift = bits ? NumBits(bits) - kMaxMagnitudeBits : 0;
+    if (shift > 0) {
+      for (size_t i = 0; i < size; ++i) {
+        data[i] >>= shift;
+      }
+    } else if (shift < 0) {
+      for (size_t i = 0; i < size; ++i) {
+        uint32_t x = static_cast<uint32_t>(data[i]);
+        data[i] = static_cast<int32_t>(x << -shift);
+      }
+    }
+    return shift;
+  }
+  
+  static inline int32_t Multiply(int32_t a, int32_t b) {
+    int64_t p = static_cast<int64_t>(a) * b;
+    return static_cast<int32_t>((p + (1 << 30)) >> 31);
+  }
+  
+  // a * b + c * d, rounded once.
+  static inline int32_t MultiplyAdd(
+      int32_t a, int32_t b, int32_t c, int32_t d) {
+    int64_t p = static_cast<int64_t>(a) * b + static_cast<int64_t>(c) * d;
+    return static_cast<int32_t>((p + (1 << 30)) >> 31);
+  }
+  
+  // Bit reversal of the index following the one whose bit reversal is r, for
+  // indices in [0, range[.
+  static inline size_t NextBitReversed(size_t r, size_t range) {
+    size_t bit = range >> 1;
+    while (r & bit) {
+      r ^= bit;
+      bit >>= 1;
+    }
+    return r | bit;
+  }
+  
+  int32_t trig_lut_[(1 << (num_passes - 1)) - 4];
+  
+  DISALLOW_COPY_AND_ASSIGN(ShyFFT);
+};
+
 }  // namespace stmlib
 
 #endif  // STMLIB_FFT_SHY_FFT_H_
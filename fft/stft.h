@@ -0,0 +1,193 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Short-time Fourier transform analysis and weighted overlap-add resynthesis.
+//
+// The input is windowed (Hann) into frames of fft_size samples, every hop_size
+// samples. For each frame, a caller-supplied processor modifies the spectrum
+// in place, in ShyFFT's packed format (real parts in [0, fft_size / 2],
+// imaginary parts in ]fft_size / 2, fft_size[). The frame is then transformed
+// back, windowed with a synthesis window normalized for the hop size, and
+// overlap-added to the output: an unmodified spectrum is reconstructed
+// perfectly, with a latency of fft_size samples.
+//
+// The processor is any object with a void operator()(float* spectrum).
+
+#ifndef STMLIB_FFT_STFT_H_
+#define STMLIB_FFT_STFT_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "stmlib/fft/shy_fft.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+namespace stmlib {
+
+template<size_t fft_size>
+class Stft {
+ public:
+  Stft() { }
+  ~Stft() { }
+  
+  // hop_size must be a power of 2, at most fft_size / 2. If the allocator
+  // runs out of memory, the output is silent.
+  void Init(BufferAllocator* allocator, size_t hop_size) {
+    assert(hop_size > 0 && (hop_size & (hop_size - 1)) == 0);
+    assert(hop_size <= fft_size / 2);
+    fft_.Init();
+    hop_size_ = hop_size;
+    
+    input_ = allocator->Allocate<float>(fft_size);
+    output_ = allocator->Allocate<float>(fft_size);
+    workspace_ = allocator->Allocate<float>(fft_size);
+    spectrum_ = allocator->Allocate<float>(fft_size);
+    window_ = allocator->Allocate<float>(fft_size);
+    normalization_ = allocator->Allocate<float>(hop_size);
+    if (!input_ || !output_ || !workspace_ || !spectrum_ || !window_ ||
+        !normalization_) {
+      input_ = NULL;
+      return;
+    }
+    
+    float increment = 2.0f * 3.141592653589793f / static_cast<float>(fft_size);
+    for (size_t i = 0; i < fft_size; ++i) {
+      window_[i] = 0.5f - 0.5f * cosf(increment * static_cast<float>(i));
+    }
+    
+    // The synthesis window is the analysis window divided by the sum of the
+    // squared windows overlapping at this sample. This also compensates for
+    // the fft_size gain of the inverse transform.
+    for (size_t i = 0; i < hop_size; ++i) {
+      float sum = 0.0f;
+      for (size_t j = i; j < fft_size; j += hop_size) {
+        sum += window_[j] * window_[j];
+      }
+      normalization_[i] = 1.0f / (sum * static_cast<float>(fft_size));
+    }
+    Reset();
+  }
+  
+  void Reset() {
+    if (!input_) {
+      return;
+    }
+    std::fill(&input_[0], &input_[fft_size], 0.0f);
+    std::fill(&output_[0], &output_[fft_size], 0.0f);
+    position_ = 0;
+    hop_position_ = 0;
+  }
+  
+  // in and out can be the same buffer.
+  template<typename Processor>
+  void Process(
+      const float* in,
+      float* out,
+      size_t size,
+      Processor* processor) {
+    if (!input_) {
+      std::fill(&out[0], &out[size], 0.0f);
+      return;
+    }
+    
+    while (size) {
+      size_t n = std::min(size, hop_size_ - hop_position_);
+      
+      // The output ring buffer is read fft_size samples after the first
+      // frame overlapping it has been added, by which time it is complete.
+      float* input = &input_[position_];
+      float* output = &output_[position_];
+      for (size_t i = 0; i < n; ++i) {
+        float x = in[i];
+        out[i] = output[i];
+        output[i] = 0.0f;
+        input[i] = x;
+      }
+      in += n;
+      out += n;
+      size -= n;
+      position_ = (position_ + n) & (fft_size - 1);
+      hop_position_ += n;
+      
+      if (hop_position_ == hop_size_) {
+        hop_position_ = 0;
+        ProcessFrame(processor);
+      }
+    }
+  }
+  
+  inline size_t hop_size() const { return hop_size_; }
+  
+ private:
+  template<typename Processor>
+  void ProcessFrame(Processor* processor) {
+    // The oldest sample of the frame is at position_, since the ring buffer
+    // is fft_size long.
+    size_t head = fft_size - position_;
+    for (size_t i = 0; i < head; ++i) {
+      workspace_[i] = input_[position_ + i] * window_[i];
+    }
+    for (size_t i = head; i < fft_size; ++i) {
+      workspace_[i] = input_[i - head] * window_[i];
+    }
+    
+    fft_.Direct(workspace_, spectrum_);
+    (*processor)(spectrum_);
+    fft_.Inverse(spectrum_, workspace_);
+    
+    const size_t hop_mask = hop_size_ - 1;
+    for (size_t i = 0; i < head; ++i) {
+      float w = window_[i] * normalization_[i & hop_mask];
+      output_[position_ + i] += workspace_[i] * w;
+    }
+    for (size_t i = head; i < fft_size; ++i) {
+      float w = window_[i] * normalization_[i & hop_mask];
+      output_[i - head] += workspace_[i] * w;
+    }
+  }
+  
+  ShyFFT<float, fft_size, LutPhasor> fft_;
+  
+  float* input_;
+  float* output_;
+  float* workspace_;
+  float* spectrum_;
+  float* window_;
+  float* normalization_;
+  
+  size_t hop_size_;
+  size_t position_;
+  size_t hop_position_;
+  
+  DISALLOW_COPY_AND_ASSIGN(Stft);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_STFT_H_
@@ -0,0 +1,231 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Accuracy checks for stmlib/fft, to be run on the host as part of a project's
+// test build (C++14):
+//
+//   stmlib::FftTest test(stdout);
+//   return test.Run() ? 0 : 1;
+//
+// Same output as FilterTest: one CSV line per check, with the measured error,
+// the bound it is held to, and the result. The references are computed
+// directly, in double precision.
+
+#ifndef STMLIB_TEST_FFT_TEST_H_
+#define STMLIB_TEST_FFT_TEST_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/fft/dft_bank.h"
+#include "stmlib/fft/non_uniform_convolver.h"
+#include "stmlib/fft/partitioned_convolver.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace stmlib {
+
+class FftTest {
+ public:
+  enum {
+    signal_size = 4096,
+    max_ir_size = 1024,
+    buffer_size = 262144
+  };
+  
+  FftTest(FILE* fp) : fp_(fp) {
+    for (size_t i = 0; i < signal_size; ++i) {
+      in_[i] = 0.5f * sinf(2.0f * 3.1415926f * 37.0f / 256.0f * i) +
+          static_cast<float>(rand()) / RAND_MAX - 0.5f;
+    }
+    // Noise with an exponential decay.
+    for (size_t i = 0; i < max_ir_size; ++i) {
+      ir_[i] = expf(-4.0f * i / max_ir_size) * (
+          static_cast<float>(rand()) / RAND_MAX - 0.5f);
+    }
+  }
+  ~FftTest() { }
+  
+  bool Run() {
+    fprintf(fp_, "check,error,bound,result\n");
+    
+    bool ok = true;
+    ok = TestSlidingDftRetune() && ok;
+    ok = TestPartitionedConvolver() && ok;
+    ok = TestNonUniformConvolver() && ok;
+    return ok;
+  }
+  
+ private:
+  bool Check(const char* name, double error, double bound) {
+    bool ok = error <= bound;
+    fprintf(fp_, "%s,%g,%g,%s\n", name, error, bound, ok ? "ok" : "FAIL");
+    return ok;
+  }
+  
+  // Magnitude of the DFT at frequency f of the window_size samples ending
+  // with x[end - 1].
+  static double Dft(const float* x, size_t end, size_t window_size, double f) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t k = 0; k < window_size; ++k) {
+      double phase = 2.0 * M_PI * f * static_cast<double>(k);
+      re += x[end - 1 - k] * cos(phase);
+      im += x[end - 1 - k] * sin(phase);
+    }
+    return sqrt(re * re + im * im);
+  }
+  
+  // Largest difference between the output of a convolver and the direct
+  // convolution of in_ with the first ir_size samples of ir_, relative to the
+  // peak of the latter. The input is processed in chunks of 1 to 3 blocks.
+  template<typename Convolver>
+  double ConvolutionError(
+      Convolver* convolver,
+      size_t block_size,
+      size_t ir_size) {
+    BufferAllocator allocator(buffer_, buffer_size);
+    convolver->Init(&allocator, max_ir_size);
+    convolver->set_impulse_response(ir_, ir_size);
+    
+    float out[signal_size];
+    size_t chunk = 0;
+    for (size_t position = 0; position < signal_size; ) {
+      size_t size = std::min(
+          block_size * (1 + chunk++ % 3),
+          signal_size - position);
+      convolver->Process(&in_[position], &out[position], size);
+      position += size;
+    }
+    
+    double error = 0.0;
+    double peak = 0.0;
+    for (size_t i = 0; i < signal_size; ++i) {
+      double reference = 0.0;
+      for (size_t j = 0; j < std::min(ir_size, i + 1); ++j) {
+        reference += static_cast<double>(ir_[j]) * in_[i - j];
+      }
+      error = std::max(error, fabs(out[i] - reference));
+      peak = std::max(peak, fabs(reference));
+    }
+    return error / peak;
+  }
+  
+  // Impulse responses shorter than a partition, ending in the middle of a
+  // partition, and filling all the allocated partitions.
+  bool TestPartitionedConvolver() {
+    const size_t ir_sizes[] = { 20, 100, 128, max_ir_size };
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(ir_sizes) / sizeof(ir_sizes[0]); ++i) {
+      PartitionedConvolver<32> convolver;
+      char name[64];
+      snprintf(
+          name, sizeof(name), "PartitionedConvolver ir_size=%zu", ir_sizes[i]);
+      ok = Check(
+          name, ConvolutionError(&convolver, 32, ir_sizes[i]), 1e-5) && ok;
+    }
+    return ok;
+  }
+  
+  // With blocks of 16 samples, and partitions of up to 64 samples, the
+  // head covers taps [0, 16[, stage 0 [16, 64[, stage 1 [64, 128[ and stage 2
+  // the rest. The impulse responses end in the head, in the middle of a
+  // partition of each stage, at the boundary between two stages, and on the
+  // last allocated tap.
+  bool TestNonUniformConvolver() {
+    const size_t ir_sizes[] = { 10, 40, 64, 100, 300, max_ir_size };
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(ir_sizes) / sizeof(ir_sizes[0]); ++i) {
+      NonUniformConvolver<16, 64> convolver;
+      char name[64];
+      snprintf(
+          name, sizeof(name), "NonUniformConvolver ir_size=%zu", ir_sizes[i]);
+      ok = Check(
+          name, ConvolutionError(&convolver, 16, ir_sizes[i]), 1e-5) && ok;
+    }
+    return ok;
+  }
+  
+  // Retunes the bins of a SlidingDftBank while it runs - to an integer bin
+  // and to a frequency between bins - and compares them with a direct DFT
+  // right after the change, and until the next resync. Each change lands at a
+  // different point of the resync cycle.
+  bool TestSlidingDftRetune() {
+    const size_t window_size = 256;
+    const float frequencies[][2] = {
+      { 10.0f / window_size, 37.0f / window_size },
+      { 0.1f, 23.3f / window_size },
+      { 0.3f, 0.05f },
+      { 37.0f / window_size, 0.4f }
+    };
+    const size_t num_bins = sizeof(frequencies) / sizeof(frequencies[0]);
+    SlidingDftBank<num_bins, window_size> dft;
+    dft.Init();
+    for (size_t i = 0; i < num_bins; ++i) {
+      dft.set_frequency(i, frequencies[i][0]);
+    }
+    
+    double error = 0.0;
+    size_t retune = 700;
+    size_t position = 0;
+    for (size_t end = 32; end <= signal_size; end += 32) {
+      dft.Process(&in_[position], end - position);
+      position = end;
+      if (end >= retune) {
+        for (size_t i = 0; i < num_bins; ++i) {
+          dft.set_frequency(i, frequencies[i][(retune / 700) & 1]);
+        }
+        retune += 700;
+      }
+      if (end < window_size) {
+        continue;
+      }
+      // The frequencies set at the previous retune.
+      size_t set = ((retune - 700) / 700) & 1;
+      for (size_t i = 0; i < num_bins; ++i) {
+        double reference = Dft(in_, end, window_size, frequencies[i][set]);
+        error = std::max(
+            error,
+            fabs(dft.magnitude(i) - reference) / std::max(reference, 1.0));
+      }
+    }
+    return Check("SlidingDftBank retune", error, 5e-3);
+  }
+  
+  FILE* fp_;
+  float in_[signal_size];
+  float ir_[max_ir_size];
+  uint8_t buffer_[buffer_size];
+  
+  DISALLOW_COPY_AND_ASSIGN(FftTest);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_TEST_FFT_TEST_H_
@@ -0,0 +1,440 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Throughput benchmark for the filters of stmlib/dsp/filter.h, to be run on
+// the host as part of a project's test build (C++11):
+//
+//   stmlib::FilterBenchmark benchmark(stdout);
+//   benchmark.Run();
+//
+// Sweeps filter, mode, frequency approximation and block size (1 to 4096),
+// and writes one CSV line per combination with the processing cost in
+// ns/sample and cycles/sample (x86 only, from the TSC), and the cost in ns of
+// one coefficient update. The fixed-point filters of
+// stmlib/dsp/fixed_point_filter.h are measured on a 16-bit copy of the same
+// signal, for comparison with their float versions. FREQUENCY_LUT needs
+// C++14: with C++11, its rows are skipped.
+//
+//   benchmark.RunDenormals();
+//
+// compares the cost of processing a signal with the cost of processing the
+// silence which follows it, while the filters' states decay through the
+// subnormal range. Each filter is measured without protection (or with
+// STMLIB_PREVENT_DENORMALS, when the benchmark is built with it), then with
+// ScopedFlushDenormals.
+
+#ifndef STMLIB_TEST_FILTER_BENCHMARK_H_
+#define STMLIB_TEST_FILTER_BENCHMARK_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/fixed_point_filter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define STMLIB_BENCHMARK_HAS_TSC
+#endif  // __i386__ || __x86_64__
+
+namespace stmlib {
+
+class FilterBenchmark {
+ public:
+  enum {
+    max_block_size = 4096
+  };
+
+  FilterBenchmark(FILE* fp, size_t samples_per_measurement = 1 << 18)
+      : fp_(fp),
+        samples_per_measurement_(samples_per_measurement) {
+    for (size_t i = 0; i < max_block_size; ++i) {
+      in_[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+      fixed_in_[i] = static_cast<int16_t>(in_[i] * 32767.0f);
+    }
+    std::fill(&silence_[0], &silence_[tail_block_size], 0.0f);
+  }
+  ~FilterBenchmark() { }
+  
+  void Run() {
+    fprintf(fp_, "filter,mode,approximation,block_size,"
+        "ns_per_sample,cycles_per_sample,update_ns\n");
+    
+    RunSvf<FILTER_MODE_LOW_PASS>();
+    RunSvf<FILTER_MODE_BAND_PASS>();
+    RunSvf<FILTER_MODE_BAND_PASS_NORMALIZED>();
+    RunSvf<FILTER_MODE_HIGH_PASS>();
+    
+    RunNaiveSvf<FILTER_MODE_LOW_PASS>();
+    RunNaiveSvf<FILTER_MODE_BAND_PASS>();
+    RunNaiveSvf<FILTER_MODE_BAND_PASS_NORMALIZED>();
+    RunNaiveSvf<FILTER_MODE_HIGH_PASS>();
+    
+    RunChamberlin<ModifiedSvf, FILTER_MODE_LOW_PASS>("ModifiedSvf");
+    RunChamberlin<ModifiedSvf, FILTER_MODE_BAND_PASS>("ModifiedSvf");
+    RunChamberlin<ModifiedSvf, FILTER_MODE_BAND_PASS_NORMALIZED>(
+        "ModifiedSvf");
+    RunChamberlin<ModifiedSvf, FILTER_MODE_HIGH_PASS>("ModifiedSvf");
+    
+    RunChamberlin<CrossoverSvf, FILTER_MODE_LOW_PASS>("CrossoverSvf");
+    RunChamberlin<CrossoverSvf, FILTER_MODE_BAND_PASS>("CrossoverSvf");
+    RunChamberlin<CrossoverSvf, FILTER_MODE_BAND_PASS_NORMALIZED>(
+        "CrossoverSvf");
+    RunChamberlin<CrossoverSvf, FILTER_MODE_HIGH_PASS>("CrossoverSvf");
+    
+    RunOnePole<FILTER_MODE_LOW_PASS>();
+    RunOnePole<FILTER_MODE_HIGH_PASS>();
+    
+    RunDCBlocker();
+    
+    RunFixedPointSvf<FILTER_MODE_LOW_PASS>();
+    RunFixedPointSvf<FILTER_MODE_BAND_PASS>();
+    RunFixedPointSvf<FILTER_MODE_BAND_PASS_NORMALIZED>();
+    RunFixedPointSvf<FILTER_MODE_HIGH_PASS>();
+    
+    RunFixedPointOnePole<FILTER_MODE_LOW_PASS>();
+    RunFixedPointOnePole<FILTER_MODE_HIGH_PASS>();
+    
+    RunFixedPointDCBlocker();
+  }
+  
+  void RunDenormals() {
+    fprintf(fp_, "filter,protection,signal_ns_per_sample,tail_ns_per_sample\n");
+#ifdef STMLIB_PREVENT_DENORMALS
+    RunTails("PREVENT_DENORMALS");
+#else
+    RunTails("NONE");
+#endif  // STMLIB_PREVENT_DENORMALS
+    ScopedFlushDenormals flush_denormals;
+    RunTails("FLUSH_DENORMALS");
+  }
+  
+ private:
+  enum {
+    tail_block_size = 64
+  };
+  
+  static const char* mode_name(FilterMode mode) {
+    switch (mode) {
+      case FILTER_MODE_LOW_PASS: return "LOW_PASS";
+      case FILTER_MODE_BAND_PASS: return "BAND_PASS";
+      case FILTER_MODE_BAND_PASS_NORMALIZED: return "BAND_PASS_NORMALIZED";
+      case FILTER_MODE_HIGH_PASS: return "HIGH_PASS";
+    }
+    return "";
+  }
+  
+  static const char* approximation_name(FrequencyApproximation approximation) {
+    switch (approximation) {
+      case FREQUENCY_EXACT: return "EXACT";
+      case FREQUENCY_ACCURATE: return "ACCURATE";
+      case FREQUENCY_FAST: return "FAST";
+      case FREQUENCY_DIRTY: return "DIRTY";
+      case FREQUENCY_LUT: return "LUT";
+    }
+    return "";
+  }
+  
+  // Prevents the compiler from optimizing away the work done on an object.
+  static inline void ClobberMemory(const void* object) {
+    __asm__ __volatile__ ("" : : "r" (object) : "memory");
+  }
+  
+  static inline uint64_t cycles() {
+#ifdef STMLIB_BENCHMARK_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif  // STMLIB_BENCHMARK_HAS_TSC
+  }
+  
+  // Average cost, in ns, of one call to update(f).
+  template<typename Update>
+  double MeasureUpdate(const void* object, Update update) {
+    const size_t num_updates = 65536;
+    std::chrono::steady_clock::time_point start = \
+        std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_updates; ++i) {
+      update(0.001f + 0.2f * static_cast<float>(i) / num_updates);
+      ClobberMemory(object);
+    }
+    std::chrono::steady_clock::time_point end = \
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / \
+        num_updates;
+  }
+  
+  template<typename Process>
+  void Measure(
+      const char* filter,
+      const char* mode,
+      const char* approximation,
+      double update_ns,
+      Process process) {
+    for (size_t block_size = 1; block_size <= max_block_size; block_size <<= 1) {
+      size_t num_blocks = samples_per_measurement_ / block_size;
+      size_t num_samples = num_blocks * block_size;
+      
+      std::chrono::steady_clock::time_point start = \
+          std::chrono::steady_clock::now();
+      uint64_t start_cycles = cycles();
+      for (size_t i = 0; i < num_blocks; ++i) {
+        process(in_, out_, block_size);
+        ClobberMemory(out_);
+      }
+      uint64_t end_cycles = cycles();
+      std::chrono::steady_clock::time_point end = \
+          std::chrono::steady_clock::now();
+      
+      double ns = std::chrono::duration<double, std::nano>(end - start).count();
+      fprintf(fp_, "%s,%s,%s,%zu,%.3f,", filter, mode, approximation,
+          block_size, ns / num_samples);
+#ifdef STMLIB_BENCHMARK_HAS_TSC
+      fprintf(fp_, "%.3f,",
+          static_cast<double>(end_cycles - start_cycles) / num_samples);
+#else
+      fprintf(fp_, ",");
+#endif  // STMLIB_BENCHMARK_HAS_TSC
+      fprintf(fp_, "%.3f\n", update_ns);
+    }
+  }
+  
+  template<FilterMode mode, FrequencyApproximation approximation>
+  void RunSvf() {
+    Svf svf;
+    svf.Init();
+    double update_ns = MeasureUpdate(&svf, [&svf](float f) {
+      svf.set_f_q<approximation>(f, 2.0f);
+    });
+    svf.set_f_q<approximation>(0.01f, 2.0f);
+    Measure("Svf", mode_name(mode), approximation_name(approximation),
+        update_ns, [&svf](const float* in, float* out, size_t size) {
+      svf.Process<mode>(in, out, size);
+    });
+  }
+  
+  template<FilterMode mode>
+  void RunSvf() {
+    RunSvf<mode, FREQUENCY_EXACT>();
+    RunSvf<mode, FREQUENCY_ACCURATE>();
+    RunSvf<mode, FREQUENCY_FAST>();
+    RunSvf<mode, FREQUENCY_DIRTY>();
+#if __cplusplus >= 201402L
+    RunSvf<mode, FREQUENCY_LUT>();
+#endif  // __cplusplus
+  }
+  
+  template<FilterMode mode, FrequencyApproximation approximation>
+  void RunNaiveSvf() {
+    NaiveSvf svf;
+    svf.Init();
+    double update_ns = MeasureUpdate(&svf, [&svf](float f) {
+      svf.set_f_q<approximation>(f, 2.0f);
+    });
+    svf.set_f_q<approximation>(0.01f, 2.0f);
+    Measure("NaiveSvf", mode_name(mode), approximation_name(approximation),
+        update_ns, [&svf](const float* in, float* out, size_t size) {
+      svf.Process<mode>(in, out, size);
+    });
+  }
+  
+  template<FilterMode mode>
+  void RunNaiveSvf() {
+    RunNaiveSvf<mode, FREQUENCY_EXACT>();
+    RunNaiveSvf<mode, FREQUENCY_FAST>();
+  }
+  
+  // ModifiedSvf and CrossoverSvf take their coefficients directly.
+  template<typename T, FilterMode mode>
+  void RunChamberlin(const char* name) {
+    T svf;
+    svf.Init();
+    double update_ns = MeasureUpdate(&svf, [&svf](float f) {
+      svf.set_f_fq(f, f * 0.5f);
+    });
+    svf.set_f_fq(0.05f, 0.05f);
+    Measure(name, mode_name(mode), "",
+        update_ns, [&svf](const float* in, float* out, size_t size) {
+      svf.template Process<mode>(in, out, size);
+    });
+  }
+  
+  template<FilterMode mode, FrequencyApproximation approximation>
+  void RunOnePole() {
+    OnePole one_pole;
+    one_pole.Init();
+    double update_ns = MeasureUpdate(&one_pole, [&one_pole](float f) {
+      one_pole.set_f<approximation>(f);
+    });
+    one_pole.set_f<approximation>(0.01f);
+    Measure("OnePole", mode_name(mode), approximation_name(approximation),
+        update_ns, [&one_pole](const float* in, float* out, size_t size) {
+      std::copy(&in[0], &in[size], &out[0]);
+      one_pole.Process<mode>(out, size);
+    });
+  }
+  
+  template<FilterMode mode>
+  void RunOnePole() {
+    RunOnePole<mode, FREQUENCY_EXACT>();
+    RunOnePole<mode, FREQUENCY_ACCURATE>();
+    RunOnePole<mode, FREQUENCY_FAST>();
+    RunOnePole<mode, FREQUENCY_DIRTY>();
+#if __cplusplus >= 201402L
+    RunOnePole<mode, FREQUENCY_LUT>();
+#endif  // __cplusplus
+  }
+  
+  void RunDCBlocker() {
+    DCBlocker dc_blocker;
+    dc_blocker.Init(0.999f);
+    double update_ns = MeasureUpdate(&dc_blocker, [&dc_blocker](float f) {
+      dc_blocker.Init(1.0f - f * 0.01f);
+    });
+    Measure("DCBlocker", "", "",
+        update_ns, [&dc_blocker](const float* in, float* out, size_t size) {
+      std::copy(&in[0], &in[size], &out[0]);
+      dc_blocker.Process(out, size);
+    });
+  }
+  
+  // The fixed-point filters process fixed_in_ into fixed_out_, and ignore the
+  // float buffers.
+  template<FilterMode mode>
+  void RunFixedPointSvf() {
+    FixedPointSvf svf;
+    svf.Init();
+    double update_ns = MeasureUpdate(&svf, [&svf](float f) {
+      svf.set_f_q<FREQUENCY_EXACT>(f, 2.0f);
+    });
+    svf.set_f_q<FREQUENCY_EXACT>(0.01f, 2.0f);
+    Measure("FixedPointSvf", mode_name(mode), "EXACT",
+        update_ns, [this, &svf](const float*, float*, size_t size) {
+      svf.Process<mode>(fixed_in_, fixed_out_, size);
+    });
+  }
+  
+  template<FilterMode mode>
+  void RunFixedPointOnePole() {
+    FixedPointOnePole one_pole;
+    one_pole.Init();
+    double update_ns = MeasureUpdate(&one_pole, [&one_pole](float f) {
+      one_pole.set_f<FREQUENCY_EXACT>(f);
+    });
+    one_pole.set_f<FREQUENCY_EXACT>(0.01f);
+    Measure("FixedPointOnePole", mode_name(mode), "EXACT",
+        update_ns, [this, &one_pole](const float*, float*, size_t size) {
+      std::copy(&fixed_in_[0], &fixed_in_[size], &fixed_out_[0]);
+      one_pole.Process<mode>(fixed_out_, size);
+    });
+  }
+  
+  void RunFixedPointDCBlocker() {
+    FixedPointDCBlocker dc_blocker;
+    dc_blocker.Init(0.999f);
+    double update_ns = MeasureUpdate(&dc_blocker, [&dc_blocker](float f) {
+      dc_blocker.Init(1.0f - f * 0.01f);
+    });
+    Measure("FixedPointDCBlocker", "", "",
+        update_ns, [this, &dc_blocker](const float*, float*, size_t size) {
+      std::copy(&fixed_in_[0], &fixed_in_[size], &fixed_out_[0]);
+      dc_blocker.Process(fixed_out_, size);
+    });
+  }
+  
+  // Average cost, in ns per sample, of processing num_blocks blocks of in.
+  template<typename Process>
+  double MeasureBlocks(const float* in, size_t num_blocks, Process process) {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_blocks; ++i) {
+      process(in, out_, tail_block_size);
+      ClobberMemory(out_);
+    }
+    std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+        (num_blocks * tail_block_size);
+  }
+  
+  template<typename Process>
+  void MeasureTail(
+      const char* filter,
+      const char* protection,
+      Process process) {
+    size_t num_blocks = samples_per_measurement_ / tail_block_size;
+    double signal_ns = MeasureBlocks(in_, num_blocks, process);
+    double tail_ns = MeasureBlocks(silence_, num_blocks, process);
+    fprintf(fp_, "%s,%s,%.3f,%.3f\n", filter, protection, signal_ns, tail_ns);
+  }
+  
+  // Low cutoffs and resonances give long decays.
+  void RunTails(const char* protection) {
+    Svf svf;
+    svf.Init();
+    svf.set_f_q<FREQUENCY_EXACT>(0.002f, 4.0f);
+    MeasureTail("Svf", protection,
+        [&svf](const float* in, float* out, size_t size) {
+      svf.Process<FILTER_MODE_LOW_PASS>(in, out, size);
+    });
+    
+    OnePole one_pole;
+    one_pole.Init();
+    one_pole.set_f<FREQUENCY_EXACT>(0.002f);
+    MeasureTail("OnePole", protection,
+        [&one_pole](const float* in, float* out, size_t size) {
+      std::copy(&in[0], &in[size], &out[0]);
+      one_pole.Process<FILTER_MODE_LOW_PASS>(out, size);
+    });
+    
+    MultibandCrossover<3> crossover;
+    crossover.Init();
+    crossover.set_f<FREQUENCY_EXACT>(0, 0.002f);
+    crossover.set_f<FREQUENCY_EXACT>(1, 0.02f);
+    MeasureTail("MultibandCrossover", protection,
+        [&crossover](const float* in, float* out, size_t size) {
+      float* bands[3] = { out, out + size, out + 2 * size };
+      crossover.Process(in, bands, size);
+    });
+  }
+  
+  FILE* fp_;
+  size_t samples_per_measurement_;
+  float in_[max_block_size];
+  float out_[max_block_size];
+  float silence_[tail_block_size];
+  int16_t fixed_in_[max_block_size];
+  int16_t fixed_out_[max_block_size];
+  
+  DISALLOW_COPY_AND_ASSIGN(FilterBenchmark);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_TEST_FILTER_BENCHMARK_H_
@@ -0,0 +1,291 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Accuracy checks for stmlib/dsp, to be run on the host as part of a project's
+// test build (C++14):
+//
+//   stmlib::FilterTest test(stdout);
+//   return test.Run() ? 0 : 1;
+//
+// Each check writes one CSV line with the measured error, the bound it is held
+// to, and the result. Run() returns false if any check fails. The fixed-point
+// filters are held to a noise floor, in dBFS, relative to their float versions.
+
+#ifndef STMLIB_TEST_FILTER_TEST_H_
+#define STMLIB_TEST_FILTER_TEST_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/fixed_point_filter.h"
+#include "stmlib/dsp/state_space_svf.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace stmlib {
+
+class FilterTest {
+ public:
+  enum {
+    signal_size = 4099
+  };
+  
+  FilterTest(FILE* fp) : fp_(fp) {
+    for (size_t i = 0; i < signal_size; ++i) {
+      in_[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+      fixed_in_[i] = static_cast<int16_t>(in_[i] * 32767.0f);
+    }
+  }
+  ~FilterTest() { }
+  
+  bool Run() {
+    fprintf(fp_, "check,error,bound,result\n");
+    
+    bool ok = true;
+    ok = TestTanLut() && ok;
+    ok = TestStateSpaceSvf<FILTER_MODE_LOW_PASS>() && ok;
+    ok = TestStateSpaceSvf<FILTER_MODE_BAND_PASS>() && ok;
+    ok = TestStateSpaceSvf<FILTER_MODE_BAND_PASS_NORMALIZED>() && ok;
+    ok = TestStateSpaceSvf<FILTER_MODE_HIGH_PASS>() && ok;
+    ok = TestFixedPointSvf<FILTER_MODE_LOW_PASS>() && ok;
+    ok = TestFixedPointSvf<FILTER_MODE_BAND_PASS>() && ok;
+    ok = TestFixedPointSvf<FILTER_MODE_BAND_PASS_NORMALIZED>() && ok;
+    ok = TestFixedPointSvf<FILTER_MODE_HIGH_PASS>() && ok;
+    ok = TestFixedPointSvfSaturation() && ok;
+    ok = TestFixedPointOnePole<FILTER_MODE_LOW_PASS>() && ok;
+    ok = TestFixedPointOnePole<FILTER_MODE_HIGH_PASS>() && ok;
+    ok = TestFixedPointDCBlocker() && ok;
+    return ok;
+  }
+  
+ private:
+  bool Check(const char* name, double error, double bound) {
+    bool ok = error <= bound;
+    fprintf(fp_, "%s,%g,%g,%s\n", name, error, bound, ok ? "ok" : "FAIL");
+    return ok;
+  }
+  
+  static const char* mode_name(FilterMode mode) {
+    switch (mode) {
+      case FILTER_MODE_LOW_PASS: return "LOW_PASS";
+      case FILTER_MODE_BAND_PASS: return "BAND_PASS";
+      case FILTER_MODE_BAND_PASS_NORMALIZED: return "BAND_PASS_NORMALIZED";
+      case FILTER_MODE_HIGH_PASS: return "HIGH_PASS";
+    }
+    return "";
+  }
+  
+  // Largest difference between two signals, relative to the peak of the
+  // reference.
+  static double Error(const float* x, const float* reference, size_t size) {
+    double error = 0.0;
+    double peak = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+      error = std::max(error, fabs(x[i] - reference[i]));
+      peak = std::max(peak, fabs(reference[i]));
+    }
+    return error / peak;
+  }
+  
+  // Relative error of LookupTan against tan(pi * f), on a logarithmic sweep
+  // from 2^-20 to 0.497, for both signs of f.
+  bool TestTanLut() {
+    double error = 0.0;
+    double negative_error = 0.0;
+    for (double f = 1.0 / (1 << 20); f <= 0.497; f *= 1.01) {
+      double t = tan(M_PI * f);
+      double positive = LookupTan(static_cast<float>(f));
+      double negative = LookupTan(static_cast<float>(-f));
+      error = std::max(error, fabs(positive - t) / t);
+      negative_error = std::max(negative_error, fabs(negative + t) / t);
+    }
+    bool ok = true;
+    ok = Check("LookupTan", error, 1e-4) && ok;
+    ok = Check("LookupTan negative", negative_error, 1e-4) && ok;
+    float nan = LookupTan(std::numeric_limits<float>::quiet_NaN());
+    ok = Check("LookupTan NaN", std::isfinite(nan) ? 0.0 : 1.0, 0.0) && ok;
+    return ok;
+  }
+  
+  // StateSpaceSvf against Svf::Process<mode>, for a few cutoff and resonance
+  // settings. The signal size is not a multiple of the block size, so that the
+  // serial tail is exercised too.
+  template<FilterMode mode, size_t block_size>
+  double StateSpaceSvfError() {
+    const float settings[][2] = {
+      { 0.001f, 0.5f }, { 0.02f, 0.707f }, { 0.1f, 5.0f }, { 0.3f, 40.0f }
+    };
+    double error = 0.0;
+    for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); ++i) {
+      Svf svf;
+      StateSpaceSvf<mode, block_size> state_space_svf;
+      svf.Init();
+      state_space_svf.Init();
+      svf.set_f_q<FREQUENCY_EXACT>(settings[i][0], settings[i][1]);
+      state_space_svf.template set_f_q<FREQUENCY_EXACT>(
+          settings[i][0], settings[i][1]);
+      svf.Process<mode>(in_, reference_, signal_size);
+      state_space_svf.Process(in_, out_, signal_size);
+      error = std::max(error, Error(out_, reference_, signal_size));
+    }
+    return error;
+  }
+  
+  template<FilterMode mode>
+  bool TestStateSpaceSvf() {
+    char name[64];
+    snprintf(name, sizeof(name), "StateSpaceSvf %s", mode_name(mode));
+    double error = std::max(
+        StateSpaceSvfError<mode, 2>(),
+        StateSpaceSvfError<mode, 4>());
+    return Check(name, error, 1e-4);
+  }
+  
+  // RMS difference between the output of a fixed-point filter and that of its
+  // float version on the same 16-bit input, in dBFS. The float output is
+  // clipped like the fixed-point one.
+  double NoiseFloor() {
+    double energy = 0.0;
+    for (size_t i = 0; i < signal_size; ++i) {
+      double reference = std::min(
+          std::max(static_cast<double>(reference_[i]), -32768.0), 32767.0);
+      double error = fixed_out_[i] - reference;
+      energy += error * error;
+    }
+    return 20.0 * log10(sqrt(energy / signal_size) / 32768.0 + 1e-12);
+  }
+  
+  void LoadReference() {
+    std::copy(&fixed_in_[0], &fixed_in_[signal_size], &reference_[0]);
+  }
+  
+  template<FilterMode mode>
+  bool TestFixedPointSvf() {
+    const float settings[][2] = {
+      { 0.001f, 0.5f }, { 0.02f, 0.707f }, { 0.1f, 5.0f }, { 0.3f, 40.0f }
+    };
+    double noise_floor = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); ++i) {
+      Svf svf;
+      FixedPointSvf fixed_point_svf;
+      svf.Init();
+      fixed_point_svf.Init();
+      svf.set_f_q<FREQUENCY_EXACT>(settings[i][0], settings[i][1]);
+      fixed_point_svf.set_f_q<FREQUENCY_EXACT>(settings[i][0], settings[i][1]);
+      LoadReference();
+      svf.Process<mode>(reference_, reference_, signal_size);
+      fixed_point_svf.Process<mode>(fixed_in_, fixed_out_, signal_size);
+      noise_floor = std::max(noise_floor, NoiseFloor());
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "FixedPointSvf %s", mode_name(mode));
+    return Check(name, noise_floor, -90.0);
+  }
+  
+  // A full-scale square wave at a resonant setting drives the states into
+  // saturation. The filter must not overflow (run with -fsanitize=undefined
+  // to catch it), and must decay back to silence once the input stops.
+  bool TestFixedPointSvfSaturation() {
+    const float f = 0.45f;
+    for (size_t i = 0; i < signal_size; ++i) {
+      bool high = i * f - static_cast<int>(i * f) < 0.5f;
+      fixed_out_[i] = high ? 32767 : -32767;
+    }
+    FixedPointSvf svf;
+    svf.Init();
+    svf.set_f_q<FREQUENCY_EXACT>(f, 100.0f);
+    svf.Process<FILTER_MODE_BAND_PASS_NORMALIZED>(
+        fixed_out_, fixed_out_, signal_size);
+    
+    // The resonance decays slowly that close to Nyquist.
+    for (size_t i = 0; i < 8; ++i) {
+      std::fill(&fixed_out_[0], &fixed_out_[signal_size], 0);
+      svf.Process<FILTER_MODE_BAND_PASS_NORMALIZED>(
+          fixed_out_, fixed_out_, signal_size);
+    }
+    int tail = 0;
+    for (size_t i = signal_size - 256; i < signal_size; ++i) {
+      tail = std::max(tail, abs(fixed_out_[i]));
+    }
+    return Check("FixedPointSvf saturation tail", tail, 2.0);
+  }
+  
+  template<FilterMode mode>
+  bool TestFixedPointOnePole() {
+    const float settings[] = { 0.001f, 0.02f, 0.3f };
+    double noise_floor = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); ++i) {
+      OnePole one_pole;
+      FixedPointOnePole fixed_point_one_pole;
+      one_pole.Init();
+      fixed_point_one_pole.Init();
+      one_pole.set_f<FREQUENCY_EXACT>(settings[i]);
+      fixed_point_one_pole.set_f<FREQUENCY_EXACT>(settings[i]);
+      LoadReference();
+      std::copy(&fixed_in_[0], &fixed_in_[signal_size], &fixed_out_[0]);
+      one_pole.Process<mode>(reference_, signal_size);
+      fixed_point_one_pole.Process<mode>(fixed_out_, signal_size);
+      noise_floor = std::max(noise_floor, NoiseFloor());
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "FixedPointOnePole %s", mode_name(mode));
+    return Check(name, noise_floor, -90.0);
+  }
+  
+  bool TestFixedPointDCBlocker() {
+    const float settings[] = { 0.99f, 0.999f };
+    double noise_floor = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); ++i) {
+      DCBlocker dc_blocker;
+      FixedPointDCBlocker fixed_point_dc_blocker;
+      dc_blocker.Init(settings[i]);
+      fixed_point_dc_blocker.Init(settings[i]);
+      LoadReference();
+      std::copy(&fixed_in_[0], &fixed_in_[signal_size], &fixed_out_[0]);
+      dc_blocker.Process(reference_, signal_size);
+      fixed_point_dc_blocker.Process(fixed_out_, signal_size);
+      noise_floor = std::max(noise_floor, NoiseFloor());
+    }
+    return Check("FixedPointDCBlocker", noise_floor, -90.0);
+  }
+  
+  FILE* fp_;
+  float in_[signal_size];
+  float out_[signal_size];
+  float reference_[signal_size];
+  int16_t fixed_in_[signal_size];
+  int16_t fixed_out_[signal_size];
+  
+  DISALLOW_COPY_AND_ASSIGN(FilterTest);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_TEST_FILTER_TEST_H_
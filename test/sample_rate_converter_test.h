@@ -0,0 +1,200 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Checks of SampleRateConverter against the scalar multiply-adds (Accumulator
+// and PolyphaseStage) it uses on Cortex-M, to be run on the host as part of a
+// project's test build (C++14):
+//
+//   stmlib::SampleRateConverterTest test(stdout);
+//   return test.Run() ? 0 : 1;
+//
+// Same output as FilterTest. The scalar code is always available, so a single
+// build compares it with the vectorized dot products - build once more with
+// STMLIB_SRC_VECTORIZED_UP=1 to also cover the vectorized upsamplers. The
+// filters are designed by SRC_KaiserFIR, for sizes which this header
+// specializes SRC_FIR for: 2/47 and 4/112 (down), 4/56 and 8/112 (up).
+
+#ifndef STMLIB_TEST_SAMPLE_RATE_CONVERTER_TEST_H_
+#define STMLIB_TEST_SAMPLE_RATE_CONVERTER_TEST_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/fir_designer.h"
+#include "stmlib/dsp/sample_rate_converter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace stmlib {
+
+template<> struct SRC_FIR<SRC_DOWN, 2, 47>
+    : public SRC_KaiserFIR<SRC_DOWN, 2, 47> { };
+template<> struct SRC_FIR<SRC_DOWN, 4, 112>
+    : public SRC_KaiserFIR<SRC_DOWN, 4, 112> { };
+template<> struct SRC_FIR<SRC_UP, 4, 56>
+    : public SRC_KaiserFIR<SRC_UP, 4, 56> { };
+template<> struct SRC_FIR<SRC_UP, 8, 112>
+    : public SRC_KaiserFIR<SRC_UP, 8, 112> { };
+
+class SampleRateConverterTest {
+ public:
+  enum {
+    signal_size = 4096
+  };
+  
+  SampleRateConverterTest(FILE* fp) : fp_(fp) {
+    for (size_t i = 0; i < signal_size; ++i) {
+      in_[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+    }
+  }
+  ~SampleRateConverterTest() { }
+  
+  bool Run() {
+    fprintf(fp_, "check,error,bound,result\n");
+    
+    bool ok = true;
+    ok = TestDownsampler<2, 47>() && ok;
+    ok = TestDownsampler<4, 112>() && ok;
+    ok = TestUpsampler<4, 56>() && ok;
+    ok = TestUpsampler<8, 112>() && ok;
+    return ok;
+  }
+  
+ private:
+  bool Check(const char* name, double error, double bound) {
+    bool ok = error <= bound;
+    fprintf(fp_, "%s,%g,%g,%s\n", name, error, bound, ok ? "ok" : "FAIL");
+    return ok;
+  }
+  
+  // Largest difference between two signals, relative to the peak of the
+  // reference.
+  static double Error(const float* x, const float* reference, size_t size) {
+    double error = 0.0;
+    double peak = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+      error = std::max(error, fabs(x[i] - reference[i]));
+      peak = std::max(peak, fabs(reference[i]));
+    }
+    return error / peak;
+  }
+  
+  // The size samples of the input ending with in_[end - 1], most recent
+  // first, and zero before the start of the signal.
+  void LoadWindow(size_t end, size_t size, float* window) const {
+    for (size_t k = 0; k < size; ++k) {
+      window[k] = k < end ? in_[end - 1 - k] : 0.0f;
+    }
+  }
+  
+  // Process() takes one of two paths depending on the block size: blocks of
+  // at least 8 * filter_size samples are filtered in place, smaller blocks
+  // go through the circular buffer. Each is checked separately. The first
+  // path computes output j from the input ending with sample j * ratio, the
+  // second from the input ending with sample j * ratio + ratio - 1.
+  template<int32_t ratio, int32_t filter_size>
+  bool TestDownsampler() {
+    const size_t block_sizes[] = { 8 * filter_size, 2 * ratio };
+    const char* path_names[] = { "in place", "circular buffer" };
+    
+    bool ok = true;
+    for (size_t path = 0; path < 2; ++path) {
+      size_t block_size = block_sizes[path];
+      size_t input_size = signal_size / block_size * block_size;
+      SampleRateConverter<SRC_DOWN, ratio, filter_size> src;
+      src.Init();
+      for (size_t i = 0; i < input_size; i += block_size) {
+        src.Process(&in_[i], &out_[i / ratio], block_size);
+      }
+      
+      SRC_FIR<SRC_DOWN, ratio, filter_size> ir;
+      Accumulator<filter_size, 1, 1, filter_size> accumulator;
+      float window[filter_size];
+      for (size_t j = 0; j < input_size / ratio; ++j) {
+        LoadWindow(j * ratio + (path ? ratio : 1), filter_size, window);
+        reference_[j] = accumulator(window, ir);
+      }
+      
+      char name[64];
+      snprintf(
+          name, sizeof(name), "SampleRateConverter SRC_DOWN %d/%d %s",
+          static_cast<int>(ratio), static_cast<int>(filter_size),
+          path_names[path]);
+      ok = Check(
+          name, Error(out_, reference_, input_size / ratio), 1e-5) && ok;
+    }
+    return ok;
+  }
+  
+  // The input is processed in blocks of 1, 7 and 32 samples.
+  template<int32_t ratio, int32_t filter_size>
+  bool TestUpsampler() {
+    enum {
+      N = filter_size / ratio
+    };
+    const size_t block_sizes[] = { 1, 7, 32 };
+    const size_t input_size = signal_size / ratio;
+    
+    SampleRateConverter<SRC_UP, ratio, filter_size> src;
+    src.Init();
+    size_t block = 0;
+    for (size_t i = 0; i < input_size; ) {
+      size_t size = std::min(block_sizes[block++ % 3], input_size - i);
+      src.Process(&in_[i], &out_[i * ratio], size);
+      i += size;
+    }
+    
+    SRC_FIR<SRC_UP, ratio, filter_size> ir;
+    PolyphaseStage<ratio, filter_size> polyphase_stage;
+    float window[N];
+    float* y = reference_;
+    for (size_t i = 0; i < input_size; ++i) {
+      LoadWindow(i + 1, N, window);
+      FilterState<N> x;
+      x.Load(window);
+      polyphase_stage(y, x, ir);
+    }
+    
+    char name[64];
+    snprintf(
+        name, sizeof(name), "SampleRateConverter SRC_UP %d/%d",
+        static_cast<int>(ratio), static_cast<int>(filter_size));
+    return Check(name, Error(out_, reference_, signal_size), 1e-5);
+  }
+  
+  FILE* fp_;
+  float in_[signal_size];
+  float out_[signal_size];
+  float reference_[signal_size];
+  
+  DISALLOW_COPY_AND_ASSIGN(SampleRateConverterTest);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_TEST_SAMPLE_RATE_CONVERTER_TEST_H_